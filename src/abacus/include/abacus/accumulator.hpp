@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include "big_int.hpp"
+#include "limb.hpp"
+#include "mpn.hpp"
+
+namespace aba {
+
+template <typename T>
+class Accumulator;
+
+// Sum of many values (and of products, see add_product()) with the carries kept per limb instead of propagated on
+// every addition. Each limb of the sum is a column of two limbs, the low one and a count of the carries out of it, so
+// that the columns are independent and an addition is a single pass without a carry chain. The columns are folded
+// when the value is read, which wraps around modulo 2^n_bits like repeated operator+=.
+template <std::size_t Limbs, typename Limb>
+class Accumulator<BigUIntN<Limbs, Limb>> {
+public:
+    using value_t = BigUIntN<Limbs, Limb>;
+
+    constexpr Accumulator() = default;
+
+    constexpr explicit Accumulator(const value_t& value) { *this += value; }
+
+    constexpr Accumulator& operator+=(const value_t& value) {
+        reserve(1);
+        for (std::size_t i = 0; i < Limbs; ++i) {
+            add(i, value.limbs()[i]);
+        }
+        return *this;
+    }
+
+    // Adds lhs * rhs (mod 2^n_bits). The limb products of each column are summed in three limbs by product scanning
+    // and the sum goes to three columns without propagating further. All limbs take part, the fixed bounds let the
+    // loops unroll.
+    constexpr Accumulator& add_product(const value_t& lhs, const value_t& rhs) {
+        reserve(3);
+        for (std::size_t k = 0; k < Limbs; ++k) {
+            const auto [low, middle, high] = column_product(lhs.limbs().first(k + 1), rhs.limbs(), k);
+            add(k, low);
+            if (k + 1 < Limbs) {
+                add(k + 1, middle);
+            }
+            if (k + 2 < Limbs) {
+                add(k + 2, high);
+            }
+        }
+        return *this;
+    }
+
+    constexpr value_t value() const {
+        std::array<Limb, Limbs> result{};
+        Limb carry = 0;
+        Limb high = 0;
+        for (std::size_t i = 0; i < Limbs; ++i) {
+            // The carries counted in the column below and the one out of the addition there.
+            result[i] = detail::add_carry(m_low[i], high, carry);
+            high = m_carries[i];
+        }
+        return value_t(result);
+    }
+
+    constexpr void clear() { *this = Accumulator(); }
+
+private:
+    // {low, middle, high} of a[0] * b[j] + a[1] * b[j - 1] + ..., for at most Limbs terms.
+    static constexpr std::array<Limb, 3> column_product(std::span<const Limb> a, std::span<const Limb> b,
+                                                        std::size_t j) {
+        if constexpr (detail::has_double_limb_v<Limb>) {
+            using double_t = detail::double_limb_t<Limb>;
+            double_t sum = 0;
+            Limb high = 0;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                const double_t product = static_cast<double_t>(a[i]) * b[j - i];
+                sum += product;
+                high = static_cast<Limb>(high + (sum < product ? 1 : 0));
+            }
+            return {static_cast<Limb>(sum), static_cast<Limb>(sum >> detail::limb_bits<Limb>), high};
+        } else {
+            std::array<Limb, 3> sum{};
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                const auto [low, high] = detail::mul_wide(a[i], b[j - i]);
+                Limb carry = 0;
+                sum[0] = detail::add_carry(sum[0], low, carry);
+                sum[1] = detail::add_carry(sum[1], high, carry);
+                sum[2] = static_cast<Limb>(sum[2] + carry);
+            }
+            return sum;
+        }
+    }
+
+    constexpr void add(std::size_t i, Limb value) {
+        m_low[i] = static_cast<Limb>(m_low[i] + value);
+        m_carries[i] = static_cast<Limb>(m_carries[i] + (m_low[i] < value ? 1 : 0));
+    }
+
+    // Folds the columns if one of them could take fewer than additions more carries.
+    constexpr void reserve(std::size_t additions) {
+        if (m_additions > std::numeric_limits<Limb>::max() - additions) {
+            const value_t folded = value();
+            std::copy(folded.limbs().begin(), folded.limbs().end(), m_low.begin());
+            m_carries = {};
+            m_additions = 0;
+        }
+        m_additions += additions;
+    }
+
+    std::array<Limb, Limbs> m_low{};
+    std::array<Limb, Limbs> m_carries{};
+    // Additions to a single column since the last fold, which bounds its count of carries.
+    std::size_t m_additions = 0;
+};
+
+// Two's complement sums wrap around the same way as the unsigned ones.
+template <std::size_t Limbs, typename Limb>
+class Accumulator<BigIntN<Limbs, Limb>> {
+public:
+    using value_t = BigIntN<Limbs, Limb>;
+    using unsigned_t = BigUIntN<Limbs, Limb>;
+
+    constexpr Accumulator() = default;
+
+    constexpr explicit Accumulator(const value_t& value) : m_sum(unsigned_t(value)) {}
+
+    constexpr Accumulator& operator+=(const value_t& value) {
+        m_sum += unsigned_t(value);
+        return *this;
+    }
+
+    constexpr Accumulator& add_product(const value_t& lhs, const value_t& rhs) {
+        m_sum.add_product(unsigned_t(lhs), unsigned_t(rhs));
+        return *this;
+    }
+
+    constexpr value_t value() const { return value_t(m_sum.value()); }
+
+    constexpr void clear() { m_sum.clear(); }
+
+private:
+    Accumulator<unsigned_t> m_sum;
+};
+
+// lhs[0] * rhs[0] + lhs[1] * rhs[1] + ..., with the products accumulated limb by limb and the carries folded once.
+template <typename T>
+constexpr T dot(std::span<const T> lhs, std::span<const T> rhs) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("Operands must have the same size");
+    }
+    Accumulator<T> result;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        result.add_product(lhs[i], rhs[i]);
+    }
+    return result.value();
+}
+
+// values[0] + values[1] + ..., with the carries folded once.
+template <typename T>
+constexpr T sum(std::span<const T> values) {
+    Accumulator<T> result;
+    for (const auto& value : values) {
+        result += value;
+    }
+    return result.value();
+}
+
+} // namespace aba
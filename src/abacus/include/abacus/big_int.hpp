@@ -4,7 +4,20 @@
 #include <iostream>
 #include <limits>
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <charconv>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "division.hpp"
+#include "limb.hpp"
+#include "mpn.hpp"
+#include "multiplication.hpp"
+#include "radix.hpp"
 
 namespace aba {
 
@@ -28,456 +41,653 @@ constexpr T pow(T exp, T power) {
     }
 }
 
-class BigInt;
+template <std::size_t Limbs, typename Limb = uint64_t>
+class BigIntN;
+
+// Fixed width unsigned integer of Limbs limbs, arithmetic wraps around modulo 2^n_bits.
+template <std::size_t Limbs, typename Limb = uint64_t>
+class BigUIntN {
+    static_assert(std::is_unsigned_v<Limb> && (std::is_same_v<Limb, uint32_t> || std::is_same_v<Limb, uint64_t>),
+                  "Limbs must be 32 or 64 bit unsigned integers");
+    static_assert(Limbs * std::numeric_limits<Limb>::digits >= 64, "Must be at least 64 bits wide");
 
-class BigUInt {
 public:
-    static constexpr std::array<char, 22> representation = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A',
-                                                            'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K'};
+    static constexpr std::array<char, 36> representation = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
+        'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'};
 
-    using data_t = uint32_t;
-    static constexpr std::size_t data_size = 4;
+    using data_t = Limb;
+    static constexpr std::size_t data_size = Limbs;
     static constexpr std::size_t n_data_bits = std::numeric_limits<data_t>::digits;
     static constexpr std::size_t n_bits = data_size * n_data_bits;
 
-    constexpr BigUInt() {}
-
-    constexpr BigUInt(uint64_t value) {
-        m_data[0] = static_cast<uint32_t>(value);
-        m_data[1] = static_cast<uint32_t>(value >> 32);
+    constexpr BigUIntN() {}
 
-        m_data[2] = 0;
-        m_data[3] = 0;
+    constexpr BigUIntN(uint64_t value) {
+        for (auto& data : m_data) {
+            data = static_cast<data_t>(value);
+            if constexpr (n_data_bits < 64) {
+                value = value >> n_data_bits;
+            } else {
+                value = 0;
+            }
+        }
     }
 
-    constexpr BigUInt(const std::array<data_t, data_size>& data) : m_data(data) {}
+    constexpr BigUIntN(const std::array<data_t, data_size>& data) : m_data(data) {}
 
-    constexpr explicit BigUInt(const BigInt& value);
+    constexpr explicit BigUIntN(const BigIntN<Limbs, Limb>& value);
 
-    friend constexpr std::strong_ordering operator<=>(const BigUInt& lhs, const BigUInt& rhs) {
-        for (std::size_t i = data_size; i > 0; --i) {
-            if (lhs.m_data[i - 1] > rhs.m_data[i - 1]) {
-                return std::strong_ordering::greater;
-            } else if (lhs.m_data[i - 1] < rhs.m_data[i - 1]) {
-                return std::strong_ordering::less;
-            }
-        }
+    friend constexpr std::strong_ordering operator<=>(const BigUIntN& lhs, const BigUIntN& rhs) {
+        return detail::cmp<data_t>(lhs.m_data, rhs.m_data);
+    }
+
+    friend constexpr bool operator==(const BigUIntN& lhs, const BigUIntN& rhs) { return lhs.m_data == rhs.m_data; }
+
+    friend constexpr bool operator!=(const BigUIntN& lhs, const BigUIntN& rhs) { return !(lhs == rhs); }
 
-        return std::strong_ordering::equal;
+    friend constexpr BigUIntN operator+(const BigUIntN& lhs, const BigUIntN& rhs) {
+        BigUIntN result;
+        detail::add_n<data_t>(result.m_data, lhs.m_data, rhs.m_data);
+        return result;
     }
 
-    friend constexpr bool operator==(const BigUInt& lhs, const BigUInt& rhs) {
-        for (std::size_t i = 0; i < data_size; ++i) {
-            if (lhs.m_data[i] != rhs.m_data[i]) {
-                return false;
-            }
-        }
-        return true;
+    friend constexpr BigUIntN operator-(const BigUIntN& lhs, const BigUIntN& rhs) {
+        BigUIntN result;
+        detail::sub_n<data_t>(result.m_data, lhs.m_data, rhs.m_data);
+        return result;
     }
 
-    friend constexpr bool operator!=(const BigUInt& lhs, const BigUInt& rhs) { return !(lhs == rhs); }
+    friend constexpr BigUIntN operator*(const BigUIntN& lhs, const BigUIntN& rhs) {
+        const bool squaring = &lhs == &rhs || lhs == rhs;
 
-    friend constexpr BigUInt operator+(const BigUInt& lhs, const BigUInt& rhs) {
-        BigUInt result(0);
-        bool carry = false;
-        for (std::size_t i = 0; i < data_size; ++i) {
-            const uint32_t sum = lhs.m_data[i] + rhs.m_data[i];
-            result.m_data[i] = sum + (carry ? 1 : 0);
-            if (sum < lhs.m_data[i] || sum < rhs.m_data[i] || result.m_data[i] < sum) {
-                carry = true;
+        // Only the low half of the product is kept, which the subquadratic algorithms can not compute on their own, so
+        // they only pay off for much wider integers.
+        if (!std::is_constant_evaluated() && data_size >= 2 * multiplication_thresholds<data_t>::karatsuba) {
+            std::array<data_t, 2 * data_size> product;
+            if (squaring) {
+                detail::square<data_t>(product, lhs.m_data);
             } else {
-                carry = false;
+                detail::multiply<data_t>(product, lhs.m_data, rhs.m_data);
             }
+            BigUIntN result;
+            std::copy(product.begin(), product.begin() + data_size, result.m_data.begin());
+            return result;
         }
 
-        return result;
-    }
-
-    friend constexpr BigUInt operator-(const BigUInt& lhs, const BigUInt& rhs) { return lhs + (-rhs); }
-
-    friend constexpr BigUInt operator*(const BigUInt& lhs, const BigUInt& rhs) {
-        BigUInt result(0);
+        BigUIntN result(0);
 
-        // TODO overflow (wrap around?)
-        for (std::size_t i = 0; i < data_size; ++i) {
-            uint64_t intermediate = 0;
+        const std::span<data_t> product(result.m_data);
+        const std::span<const data_t> lhs_data(lhs.m_data);
 
-            for (std::size_t j = 0; j < data_size; ++j) {
-                if ((i + j) >= data_size) {
-                    continue;
+        if (squaring) {
+            // Every cross product lhs_i * lhs_j, i < j, appears twice in the square, compute them once and double.
+            for (std::size_t i = 0; 2 * i + 1 < data_size; ++i) {
+                detail::addmul_1<data_t>(product.subspan(2 * i + 1), lhs_data.subspan(i + 1, data_size - 2 * i - 1),
+                                         lhs.m_data[i]);
+            }
+            detail::lshift<data_t>(product, product, 1);
+
+            std::array<data_t, data_size> diagonal{};
+            for (std::size_t i = 0; 2 * i < data_size; ++i) {
+                const auto [low, high] = detail::mul_wide(lhs.m_data[i], lhs.m_data[i]);
+                diagonal[2 * i] = low;
+                if (2 * i + 1 < data_size) {
+                    diagonal[2 * i + 1] = high;
                 }
-                intermediate += static_cast<uint64_t>(lhs.m_data[i]) * static_cast<uint64_t>(rhs.m_data[j]);
-                result.m_data[i + j] += static_cast<uint32_t>(intermediate);
-                intermediate = intermediate >> n_data_bits;
             }
+            detail::add_n<data_t>(product, product, diagonal);
+            return result;
         }
+
+        addmul_limbs(result.m_data, lhs.m_data, rhs.m_data);
         return result;
     }
 
-    friend constexpr BigUInt operator/(const BigUInt& lhs, const BigUInt& rhs) {
-        return BigUInt::division(lhs, rhs).first;
+    friend constexpr BigUIntN operator/(const BigUIntN& lhs, const BigUIntN& rhs) {
+        return BigUIntN::division(lhs, rhs).first;
     }
 
-    friend constexpr BigUInt operator-(const BigUInt& lhs) { return ~lhs + BigUInt(1); }
+    friend constexpr BigUIntN operator-(const BigUIntN& lhs) { return BigUIntN(0) - lhs; }
 
-    friend constexpr BigUInt operator%(const BigUInt& lhs, const BigUInt& rhs) {
-        return BigUInt::division(lhs, rhs).second;
+    friend constexpr BigUIntN operator%(const BigUIntN& lhs, const BigUIntN& rhs) {
+        return BigUIntN::division(lhs, rhs).second;
     }
 
-    friend constexpr BigUInt operator~(const BigUInt& value) {
-        BigUInt result;
+    friend constexpr BigUIntN operator~(const BigUIntN& value) {
+        BigUIntN result;
 
         for (std::size_t i = 0; i < data_size; ++i) {
-            result.m_data[i] = ~value.m_data[i];
+            result.m_data[i] = static_cast<data_t>(~value.m_data[i]);
         }
 
         return result;
     }
 
-    friend constexpr BigUInt operator>>(const BigUInt& lhs, uint32_t rhs) {
-        if (rhs == 0) {
-            return lhs;
-        }
+    friend constexpr BigUIntN operator>>(const BigUIntN& lhs, uint32_t rhs) {
+        BigUIntN result = lhs;
+        return result >>= rhs;
+    }
 
-        if (rhs == 32) {
-            BigUInt result(0);
+    friend constexpr BigUIntN operator<<(const BigUIntN& lhs, uint32_t rhs) {
+        BigUIntN result = lhs;
+        return result <<= rhs;
+    }
 
-            for (std::size_t i = data_size - 1; i > 0; --i) {
-                result.m_data[i - 1] = lhs.m_data[i];
-            }
-            return result;
-        }
+    // The compound operators work on the limbs in place.
+    constexpr BigUIntN& operator+=(const BigUIntN& rhs) {
+        detail::add_n<data_t>(m_data, m_data, rhs.m_data);
+        return *this;
+    }
 
-        if (rhs > 32) {
-            return (lhs >> (rhs - 32) >> 32);
-        }
+    constexpr BigUIntN& operator-=(const BigUIntN& rhs) {
+        detail::sub_n<data_t>(m_data, m_data, rhs.m_data);
+        return *this;
+    }
 
-        BigUInt result(0);
+    // The product needs its own storage as the operands are read until the end.
+    constexpr BigUIntN& operator*=(const BigUIntN& rhs) { return *this = *this * rhs; }
 
-        uint32_t remainder = 0;
-        for (std::size_t i = data_size; i > 0; --i) {
-            result.m_data[i - 1] = (lhs.m_data[i - 1] >> rhs) | remainder;
-            remainder = lhs.m_data[i - 1] << (32 - rhs);
+    constexpr BigUIntN& operator<<=(uint32_t rhs) {
+        if (rhs >= n_bits) {
+            m_data.fill(0);
+            return *this;
         }
-        return result;
+
+        // lshift() runs from the top limb down, so it can move the limbs up in place.
+        const std::size_t limbs = rhs / n_data_bits;
+        detail::lshift<data_t>(std::span(m_data).subspan(limbs), std::span(m_data).first(data_size - limbs),
+                               rhs % n_data_bits);
+        std::fill_n(m_data.begin(), limbs, data_t{0});
+        return *this;
     }
 
-    friend constexpr BigUInt operator<<(const BigUInt& lhs, uint32_t rhs) {
-        if (rhs == 0) {
-            return lhs;
+    constexpr BigUIntN& operator>>=(uint32_t rhs) {
+        if (rhs >= n_bits) {
+            m_data.fill(0);
+            return *this;
         }
 
-        if (rhs == 32) {
-            BigUInt result(0);
+        const std::size_t limbs = rhs / n_data_bits;
+        detail::rshift<data_t>(std::span(m_data).first(data_size - limbs), std::span(m_data).subspan(limbs),
+                               rhs % n_data_bits);
+        std::fill_n(m_data.end() - static_cast<std::ptrdiff_t>(limbs), limbs, data_t{0});
+        return *this;
+    }
 
-            for (std::size_t i = 0; i < data_size - 1; ++i) {
-                result.m_data[i + 1] = lhs.m_data[i];
-            }
+    // *this += lhs * rhs, wrapping around like multiplication. The rows of the product are accumulated straight into
+    // the value, the product itself is never formed.
+    constexpr BigUIntN& addmul(const BigUIntN& lhs, const BigUIntN& rhs) {
+        addmul_limbs(m_data, lhs.m_data, rhs.m_data);
+        return *this;
+    }
 
-            return result;
+    constexpr BigUIntN& addmul(const BigUIntN& lhs, data_t factor) {
+        detail::addmul_1<data_t>(m_data, lhs.m_data, factor);
+        return *this;
+    }
+
+    // *this -= lhs * rhs, wrapping around like multiplication.
+    constexpr BigUIntN& submul(const BigUIntN& lhs, const BigUIntN& rhs) {
+        submul_limbs(m_data, lhs.m_data, rhs.m_data);
+        return *this;
+    }
+
+    constexpr BigUIntN& submul(const BigUIntN& lhs, data_t factor) {
+        detail::submul_1<data_t>(m_data, lhs.m_data, factor);
+        return *this;
+    }
+
+    // *this = *this * factor + addend, returns the limb carried out of the top.
+    constexpr data_t multiply_add(data_t factor, data_t addend) {
+        const data_t high = detail::mul_1<data_t>(m_data, m_data, factor);
+        return static_cast<data_t>(high + detail::add_in_place<data_t>(m_data, std::span(&addend, 1)));
+    }
+
+    // Throws std::invalid_argument for a zero divisor, also through the division operators of BigUIntN and BigIntN.
+    static constexpr std::pair<BigUIntN, BigUIntN> division(const BigUIntN& lhs, const BigUIntN& rhs) {
+        const std::size_t n = rhs.significant_limbs();
+        const std::size_t m = lhs.significant_limbs();
+        if (n == 0) {
+            throw std::invalid_argument("Division by zero");
         }
 
-        if (rhs > 32) {
-            return (lhs << (rhs - 32) << 32);
+        if (m < n || lhs < rhs) {
+            return {BigUIntN(0), lhs};
         }
 
-        BigUInt result(0);
+        BigUIntN quotient(0);
 
-        uint32_t remainder = 0;
-        for (std::size_t i = 0; i < data_size; ++i) {
-            result.m_data[i] = (lhs.m_data[i] << rhs) | remainder;
-            remainder = lhs.m_data[i] >> (32 - rhs);
+        if (n <= 1) {
+            quotient = lhs;
+            const data_t rem = quotient.divide_by_limb(rhs.m_data[0]);
+            return {quotient, BigUIntN(rem)};
         }
-        return result;
-    }
 
-    static constexpr std::pair<BigUInt, BigUInt> division(const BigUInt& lhs, const BigUInt& rhs) {
-        BigUInt result(0);
-        BigUInt rem = lhs;
-        BigUInt dem = rhs;
-
-        while (rem != BigUInt(0) && rem >= dem) {
-            uint32_t shifted = 0;
-            if (rem > dem) {
-                while ((rem >> shifted) > dem) {
-                    shifted += 1;
-                }
-                shifted -= 1;
-            }
-            result = result + (BigUInt(1) << shifted);
-            rem = rem - (dem << shifted);
+        BigUIntN remainder(0);
+        if (!std::is_constant_evaluated() && std::min(n, m - n + 1) >= division_thresholds<data_t>::recursive) {
+            detail::divide<data_t>(std::span(quotient.m_data).first(m - n + 1), std::span(remainder.m_data).first(n),
+                                   std::span(lhs.m_data).first(m), std::span(rhs.m_data).first(n));
+            return {quotient, remainder};
         }
 
-        return {result, rem};
+        std::array<data_t, 2 * data_size + 1> scratch{};
+        detail::divrem<data_t>(std::span(quotient.m_data).first(m - n + 1), std::span(remainder.m_data).first(n),
+                               std::span(lhs.m_data).first(m), std::span(rhs.m_data).first(n), scratch);
+        return {quotient, remainder};
     }
 
-    static constexpr BigUInt pow(const BigUInt& lhs, uint32_t exponent) {
-        BigUInt result = 1;
-        for (std::size_t i = 0; i < exponent; ++i) {
-            result = result * lhs;
+    // lhs^exponent by square and multiply, wrapping around like multiplication.
+    static constexpr BigUIntN pow(const BigUIntN& lhs, uint32_t exponent) {
+        BigUIntN result = 1;
+        BigUIntN square = lhs;
+        while (exponent != 0) {
+            if ((exponent & 1) != 0) {
+                result = result * square;
+            }
+            exponent = exponent >> 1;
+            if (exponent != 0) {
+                square = square * square;
+            }
         }
         return result;
     }
 
-    uint32_t digits(uint32_t base) const {
-        if (*this == BigUInt(0)) {
-            return 1;
+    // Number of bits needed to represent the value, 0 for 0.
+    constexpr std::size_t bit_length() const {
+        const std::size_t limbs = significant_limbs();
+        if (limbs == 0) {
+            return 0;
         }
+        return limbs * n_data_bits - static_cast<std::size_t>(std::countl_zero(m_data[limbs - 1]));
+    }
 
-        auto constexpr_log2 = [](uint32_t value) {
-            uint32_t result = 0;
-            while (value != 0) {
-                value = value >> 1;
-                result += 1;
+    // Number of zero bits above the most significant one bit, n_bits for 0.
+    constexpr std::size_t countl_zero() const { return n_bits - bit_length(); }
+
+    // Number of zero bits below the least significant one bit, n_bits for 0.
+    constexpr std::size_t countr_zero() const {
+        for (std::size_t i = 0; i < data_size; ++i) {
+            if (m_data[i] != 0) {
+                return i * n_data_bits + static_cast<std::size_t>(std::countr_zero(m_data[i]));
             }
+        }
+        return n_bits;
+    }
 
-            return result - 1;
-        };
+    // Number of digits in the given base (2 to 36), estimated from the bit length, see detail::digit_count().
+    constexpr uint32_t digits(uint32_t base) const {
+        return detail::digit_count<data_t, data_size>(m_data, bit_length(), base);
+    }
 
-        BigUInt rem = *this;
-        uint32_t digits = 1;
-        const auto nb_bits = constexpr_log2((n_bits - 1) / constexpr_log2(base));
-        uint32_t count = 1 << nb_bits;
+    // Writes the digits of the value in the given base (2 to 36) to [first, last) without allocating. On success
+    // returns a pointer one past the last written character, or {last, std::errc::value_too_large} if the range is
+    // too small.
+    constexpr std::to_chars_result to_chars(char* first, char* last, uint32_t base = 10) const {
+        const uint32_t length = digits(base);
+        if (last - first < static_cast<std::ptrdiff_t>(length)) {
+            return {last, std::errc::value_too_large};
+        }
+
+        // Fill the range from the back, one limb sized chunk of digits at a time.
+        const auto [chunk, chunk_digits] = detail::digit_chunk<data_t>(base);
+        char* const end = first + length;
+        char* begin = end;
 
+        BigUIntN value = *this;
         do {
-            BigUInt base_exp = pow(BigUInt(base), count);
-            if (rem >= base_exp) {
-                digits += count;
-                rem = rem / base_exp;
+            data_t rem = value.divide_by_limb(chunk);
+            for (uint32_t i = 0; i < chunk_digits && begin != first; ++i) {
+                *--begin = representation[static_cast<std::size_t>(rem % base)];
+                rem /= base;
             }
-            count = count >> 1;
-        } while (count > 0);
+        } while (begin != first);
 
-        return digits;
+        return {end, std::errc{}};
     }
 
     std::string to_string(uint16_t base) const {
-        std::string result;
-        result.reserve(45);
+        std::string result(digits(base), '0');
+        to_chars(result.data(), result.data() + result.size(), base);
+        return result;
+    }
 
-        BigUInt value = *this;
+    // Passes the digits of the value in the given base (2 to 36) to put, most significant first, as values from 0 to
+    // base - 1. Unlike to_chars() the digits need no buffer of their own, the value is split into limb sized chunks
+    // of digits which are then taken apart from the top.
+    template <typename Put>
+    constexpr void for_each_digit(uint32_t base, Put&& put) const {
+        // A chunk is at least the square root of the limb range, or its square would have fit, so there are at most
+        // two chunks per limb.
+        std::array<data_t, 2 * data_size> chunks{};
+        std::size_t count = 0;
+        const auto [chunk, chunk_digits] = detail::digit_chunk<data_t>(base);
+        BigUIntN value = *this;
+        do {
+            chunks[count++] = value.divide_by_limb(chunk);
+        } while (value.significant_limbs() != 0);
+
+        std::array<uint32_t, n_data_bits> digits{};
+        for (std::size_t i = count; i-- > 0;) {
+            data_t rem = chunks[i];
+            uint32_t length = 0;
+            do {
+                digits[length++] = static_cast<uint32_t>(rem % base);
+                rem /= base;
+            } while (i + 1 == count ? rem != 0 : length < chunk_digits);
+            while (length > 0) {
+                put(digits[--length]);
+            }
+        }
+    }
 
-        const BigUInt big_int_base(base);
+    // Parses the digits at the start of [first, last) in the given base (2 to 36, letters in either case) like
+    // std::from_chars: on success value is set and ptr points past the digits. Without any digits ec is
+    // std::errc::invalid_argument and if the number does not fit ec is std::errc::result_out_of_range, value is left
+    // unchanged in both cases. The digits are accumulated a limb sized chunk at a time.
+    static constexpr std::from_chars_result from_chars(const char* first, const char* last, BigUIntN& value,
+                                                       uint32_t base = 10) {
+        if (base < 2 || base > 36) {
+            return {first, std::errc::invalid_argument};
+        }
 
-        do {
-            BigUInt remainder;
-            std::tie(value, remainder) = BigUInt::division(value, big_int_base);
-            result = representation[remainder.m_data[0]] + result;
-        } while (value != BigUInt(0));
+        BigUIntN result(0);
+        bool overflow = false;
+        const char* pos = first;
+        while (pos != last) {
+            data_t chunk = 0;
+            data_t scale = 1;
+            const char* next = detail::accumulate_digits(pos, last, base, chunk, scale);
+            if (next == pos) {
+                break;
+            }
+            overflow = result.multiply_add(scale, chunk) != 0 || overflow;
+            pos = next;
+        }
 
-        return result;
+        if (pos == first) {
+            return {first, std::errc::invalid_argument};
+        }
+        if (overflow) {
+            return {pos, std::errc::result_out_of_range};
+        }
+        value = result;
+        return {pos, std::errc{}};
     }
 
+    // The limbs of the value, least significant first.
+    constexpr std::span<const data_t, data_size> limbs() const { return m_data; }
+
 private:
-    friend class BigInt;
+    friend class BigIntN<Limbs, Limb>;
+
+    // Divides the value in place by a single limb and returns the remainder.
+    constexpr data_t divide_by_limb(data_t divisor) {
+        const auto value = std::span(m_data).first(significant_limbs());
+        return detail::divrem_1<data_t>(value, value, divisor);
+    }
+
+    constexpr std::size_t significant_limbs() const {
+        std::size_t count = data_size;
+        while (count > 0 && m_data[count - 1] == 0) {
+            count -= 1;
+        }
+        return count;
+    }
+
+    // value += lhs * rhs and value -= lhs * rhs modulo 2^n_bits, one row of the product per limb of rhs. The limb
+    // carried or borrowed out of a row falls off the top.
+    static constexpr void addmul_limbs(std::span<data_t, data_size> value, std::span<const data_t, data_size> lhs,
+                                       std::span<const data_t, data_size> rhs) {
+        for (std::size_t i = 0; i < data_size; ++i) {
+            if (rhs[i] != 0) {
+                detail::addmul_1<data_t>(value.subspan(i), lhs.first(data_size - i), rhs[i]);
+            }
+        }
+    }
+
+    static constexpr void submul_limbs(std::span<data_t, data_size> value, std::span<const data_t, data_size> lhs,
+                                       std::span<const data_t, data_size> rhs) {
+        for (std::size_t i = 0; i < data_size; ++i) {
+            if (rhs[i] != 0) {
+                detail::submul_1<data_t>(value.subspan(i), lhs.first(data_size - i), rhs[i]);
+            }
+        }
+    }
+
     std::array<data_t, data_size> m_data;
 };
 
-class BigInt {
+// Fixed width two's complement signed integer of Limbs limbs.
+template <std::size_t Limbs, typename Limb>
+class BigIntN {
 public:
-    using data_t = uint32_t;
-    static constexpr std::size_t data_size = 4;
+    using data_t = Limb;
+    static constexpr std::size_t data_size = Limbs;
     static constexpr std::size_t n_data_bits = std::numeric_limits<data_t>::digits;
     static constexpr std::size_t n_bits = data_size * n_data_bits;
 
-    static constexpr BigInt min() {
-        BigInt result(0);
+    static constexpr BigIntN min() {
+        BigIntN result(0);
 
-        result.m_data[3] = 1u << 31;
+        result.m_data[data_size - 1] = data_t{1} << (n_data_bits - 1);
 
         return result;
     }
 
-    static constexpr BigInt max() {
-        BigInt result(0);
+    static constexpr BigIntN max() {
+        BigIntN result(0);
 
-        const auto last = ~static_cast<uint32_t>(0);
+        const auto last = static_cast<data_t>(~data_t{0});
 
         for (auto& data : result.m_data) {
             data = last;
         }
 
-        result.m_data[3] = result.m_data[3] >> 1;
+        result.m_data[data_size - 1] = result.m_data[data_size - 1] >> 1;
 
         return result;
     }
 
-    constexpr BigInt() {}
+    constexpr BigIntN() {}
 
-    constexpr BigInt(const std::array<data_t, data_size>& data) : m_data(data) {}
+    constexpr BigIntN(const std::array<data_t, data_size>& data) : m_data(data) {}
 
-    constexpr BigInt(int64_t value) {
-        m_data[0] = static_cast<uint32_t>(value);
-        m_data[1] = static_cast<uint32_t>(value >> 32);
-        if (value >= 0) {
-            m_data[2] = 0;
-            m_data[3] = 0;
-        } else {
-            m_data[2] = ~static_cast<uint32_t>(0);
-            m_data[3] = ~static_cast<uint32_t>(0);
+    constexpr BigIntN(int64_t value) : m_data(BigUIntN<Limbs, Limb>(static_cast<uint64_t>(value)).m_data) {
+        if (value < 0) {
+            // Sign extend past the 64 bits set from the value.
+            for (std::size_t i = 64 / n_data_bits; i < data_size; ++i) {
+                m_data[i] = static_cast<data_t>(~data_t{0});
+            }
         }
     }
 
-    constexpr explicit BigInt(const BigUInt& value) : m_data(value.m_data) {}
+    constexpr explicit BigIntN(const BigUIntN<Limbs, Limb>& value) : m_data(value.m_data) {}
 
-    friend constexpr std::strong_ordering operator<=>(const BigInt& lhs, const BigInt& rhs) {
+    friend constexpr std::strong_ordering operator<=>(const BigIntN& lhs, const BigIntN& rhs) {
         if (!lhs.is_negative() && rhs.is_negative()) {
             return std::strong_ordering::greater;
         } else if (lhs.is_negative() && !rhs.is_negative()) {
             return std::strong_ordering::less;
         }
 
-        return (BigUInt(lhs) <=> BigUInt(rhs));
+        return (unsigned_t(lhs) <=> unsigned_t(rhs));
     }
 
-    friend constexpr bool operator==(const BigInt& lhs, const BigInt& rhs) {
-        for (std::size_t i = 0; i < data_size; ++i) {
-            if (lhs.m_data[i] != rhs.m_data[i]) {
-                return false;
-            }
-        }
-        return true;
-    }
+    friend constexpr bool operator==(const BigIntN& lhs, const BigIntN& rhs) { return lhs.m_data == rhs.m_data; }
 
-    friend constexpr bool operator!=(const BigInt& lhs, const BigInt& rhs) { return !(lhs == rhs); }
+    friend constexpr bool operator!=(const BigIntN& lhs, const BigIntN& rhs) { return !(lhs == rhs); }
 
-    friend constexpr BigInt operator+(const BigInt& lhs, const BigInt& rhs) {
-        return BigInt(BigUInt(lhs) + BigUInt(rhs));
+    friend constexpr BigIntN operator+(const BigIntN& lhs, const BigIntN& rhs) {
+        return BigIntN(unsigned_t(lhs) + unsigned_t(rhs));
     }
 
-    friend constexpr BigInt operator-(const BigInt& lhs, const BigInt& rhs) { return lhs + (-rhs); }
+    friend constexpr BigIntN operator-(const BigIntN& lhs, const BigIntN& rhs) {
+        return BigIntN(unsigned_t(lhs) - unsigned_t(rhs));
+    }
 
-    friend constexpr BigInt operator*(const BigInt& lhs, const BigInt& rhs) {
-        BigUInt result;
-        if (lhs.is_negative() && rhs.is_negative()) {
-            result = (BigUInt(-lhs) * BigUInt(-rhs));
-        } else if (lhs.is_negative()) {
-            result = -(BigUInt(-lhs) * BigUInt(rhs));
-        } else if (rhs.is_negative()) {
-            result = -(BigUInt(lhs) * BigUInt(-rhs));
-        } else {
-            result = BigUInt(lhs) * BigUInt(rhs);
-        }
+    // The low half of the product is the same for two's complement and unsigned operands, so the signs need no
+    // handling.
+    friend constexpr BigIntN operator*(const BigIntN& lhs, const BigIntN& rhs) {
+        return BigIntN(unsigned_t(lhs) * unsigned_t(rhs));
+    }
 
-        return BigInt(result);
+    friend constexpr BigIntN operator/(const BigIntN& lhs, const BigIntN& rhs) {
+        return BigIntN::division(lhs, rhs).first;
     }
 
-    friend constexpr BigInt operator/(const BigInt& lhs, const BigInt& rhs) { return BigInt::division(lhs, rhs).first; }
+    friend constexpr BigIntN operator-(const BigIntN& lhs) { return BigIntN(-unsigned_t(lhs)); }
 
-    friend constexpr BigInt operator-(const BigInt& lhs) { return ~lhs + BigInt(1); }
+    friend constexpr BigIntN operator%(const BigIntN& lhs, const BigIntN& rhs) {
+        return BigIntN::division(lhs, rhs).second;
+    }
 
-    friend constexpr BigInt operator%(const BigInt& lhs, const BigInt& rhs) {
-        return BigInt::division(lhs, rhs).second;
+    friend constexpr BigIntN operator~(const BigIntN& value) { return BigIntN(~unsigned_t(value)); }
+
+    friend constexpr BigIntN operator>>(const BigIntN& lhs, uint32_t rhs) {
+        BigIntN result = lhs;
+        return result >>= rhs;
     }
 
-    friend constexpr BigInt operator~(const BigInt& value) {
-        BigInt result;
+    friend constexpr BigIntN operator<<(const BigIntN& lhs, uint32_t rhs) {
+        BigIntN result = lhs;
+        return result <<= rhs;
+    }
 
-        for (std::size_t i = 0; i < data_size; ++i) {
-            result.m_data[i] = ~value.m_data[i];
-        }
+    // The compound and fused operations are those of BigUIntN on the two's complement limbs.
+    constexpr BigIntN& operator+=(const BigIntN& rhs) {
+        detail::add_n<data_t>(m_data, m_data, rhs.m_data);
+        return *this;
+    }
 
-        return result;
+    constexpr BigIntN& operator-=(const BigIntN& rhs) {
+        detail::sub_n<data_t>(m_data, m_data, rhs.m_data);
+        return *this;
     }
 
-    friend constexpr BigInt operator>>(const BigInt& lhs, uint32_t rhs) {
-        if (rhs == 0) {
-            return lhs;
-        }
+    constexpr BigIntN& operator*=(const BigIntN& rhs) { return *this = *this * rhs; }
 
-        // NOTE We only have logical shift.
+    constexpr BigIntN& operator<<=(uint32_t rhs) {
+        m_data = (unsigned_t(*this) <<= rhs).m_data;
+        return *this;
+    }
 
-        return BigInt(BigUInt(lhs) >> rhs);
+    // NOTE We only have logical shift.
+    constexpr BigIntN& operator>>=(uint32_t rhs) {
+        m_data = (unsigned_t(*this) >>= rhs).m_data;
+        return *this;
     }
 
-    friend constexpr BigInt operator<<(const BigInt& lhs, uint32_t rhs) {
-        if (rhs == 0) {
-            return lhs;
-        }
+    // *this += lhs * rhs and *this -= lhs * rhs, wrapping around like multiplication.
+    constexpr BigIntN& addmul(const BigIntN& lhs, const BigIntN& rhs) {
+        unsigned_t::addmul_limbs(m_data, lhs.m_data, rhs.m_data);
+        return *this;
+    }
 
-        return BigInt(BigUInt(lhs) << rhs);
+    constexpr BigIntN& submul(const BigIntN& lhs, const BigIntN& rhs) {
+        unsigned_t::submul_limbs(m_data, lhs.m_data, rhs.m_data);
+        return *this;
     }
 
-    static constexpr std::pair<BigInt, BigInt> division(const BigInt& lhs, const BigInt& rhs) {
+    static constexpr std::pair<BigIntN, BigIntN> division(const BigIntN& lhs, const BigIntN& rhs) {
         if (lhs.is_negative() && rhs.is_negative()) {
-            auto [result, rem] = BigUInt::division(BigUInt(-lhs), BigUInt(-rhs));
-            return {BigInt(result), -BigInt(rem)};
+            auto [result, rem] = unsigned_t::division(unsigned_t(-lhs), unsigned_t(-rhs));
+            return {BigIntN(result), -BigIntN(rem)};
         }
 
         if (lhs.is_negative()) {
-            auto [result, rem] = BigUInt::division(BigUInt(-lhs), BigUInt(rhs));
-            ;
-            return {-BigInt(result), -BigInt(rem)};
+            auto [result, rem] = unsigned_t::division(unsigned_t(-lhs), unsigned_t(rhs));
+            return {-BigIntN(result), -BigIntN(rem)};
         }
 
         if (rhs.is_negative()) {
-            auto [result, rem] = BigUInt::division(BigUInt(lhs), BigUInt(-rhs));
-            return {-BigInt(result), BigInt(rem)};
+            auto [result, rem] = unsigned_t::division(unsigned_t(lhs), unsigned_t(-rhs));
+            return {-BigIntN(result), BigIntN(rem)};
         }
 
-        auto [result, rem] = BigUInt::division(BigUInt(lhs), BigUInt(rhs));
-        return {BigInt(result), BigInt(rem)};
+        auto [result, rem] = unsigned_t::division(unsigned_t(lhs), unsigned_t(rhs));
+        return {BigIntN(result), BigIntN(rem)};
     }
 
-    static constexpr BigInt pow(const BigInt& lhs, uint32_t exponent) {
+    static constexpr BigIntN pow(const BigIntN& lhs, uint32_t exponent) {
         // TODO pow should be part of functions, but how could it then be used here?
         // Start to move stuff to a unit file?
-        return ((exponent % 2) == 0 || !lhs.is_negative() ? BigInt(1) : BigInt(-1)) *
-               BigInt(BigUInt::pow(BigUInt(lhs), exponent));
+        // The two's complement product wraps around like the unsigned one, so the sign comes out right.
+        return BigIntN(unsigned_t::pow(unsigned_t(lhs), exponent));
     }
 
-    uint32_t digits(uint32_t base) const {
-        if (is_negative()) {
-            return BigUInt(-*this).digits(base);
-        }
-        return BigUInt(*this).digits(base);
+    // Number of bits of the magnitude, 0 for 0.
+    constexpr std::size_t bit_length() const {
+        return (is_negative() ? unsigned_t(-*this) : unsigned_t(*this)).bit_length();
     }
 
-    std::string to_string(uint16_t base) const {
-        BigUInt value;
+    // Counts of the two's complement bits, see BigUIntN.
+    constexpr std::size_t countl_zero() const { return unsigned_t(*this).countl_zero(); }
+    constexpr std::size_t countr_zero() const { return unsigned_t(*this).countr_zero(); }
 
+    // Number of digits of the magnitude, without the sign.
+    constexpr uint32_t digits(uint32_t base) const {
         if (is_negative()) {
-            value = BigUInt(-(*this));
-        } else {
-            value = BigUInt(*this);
+            return unsigned_t(-*this).digits(base);
         }
-
-        return (is_negative() ? "-" : "") + value.to_string(base);
+        return unsigned_t(*this).digits(base);
     }
 
-    std::string to_string() const { return to_string(10); }
-
-    static constexpr BigInt from_string(std::string_view str, uint32_t base = 10) {
-        if (str.empty()) {
-            return BigInt(0);
+    // See BigUIntN::to_chars, negative values are prefixed with '-'.
+    constexpr std::to_chars_result to_chars(char* first, char* last, uint32_t base = 10) const {
+        if (!is_negative()) {
+            return unsigned_t(*this).to_chars(first, last, base);
         }
 
-        std::size_t pos = 0;
-        bool negative = false;
-        if (str[pos] == '-') {
-            pos += 1;
-            negative = true;
+        if (first == last) {
+            return {last, std::errc::value_too_large};
         }
 
-        // TODO Use BigUInt
-        BigInt result(0);
+        *first = '-';
+        return unsigned_t(-(*this)).to_chars(first + 1, last, base);
+    }
 
-        auto char_to_number = [](char c) -> uint8_t {
-            // TODO Support bases > 10
-            return c - '0';
-        };
+    std::string to_string(uint16_t base) const {
+        std::string result(digits(base) + (is_negative() ? 1 : 0), '0');
+        to_chars(result.data(), result.data() + result.size(), base);
+        return result;
+    }
+
+    std::string to_string() const { return to_string(10); }
 
-        while (pos < str.size()) {
-            result = result * base;
-            uint32_t value = char_to_number(str[pos]);
-            result = result + value;
-            pos += 1;
+    // See BigUIntN::from_chars, a leading '-' is accepted for negative values.
+    static constexpr std::from_chars_result from_chars(const char* first, const char* last, BigIntN& value,
+                                                       uint32_t base = 10) {
+        const bool negative = first != last && *first == '-';
+
+        unsigned_t magnitude(0);
+        const auto result = unsigned_t::from_chars(negative ? first + 1 : first, last, magnitude, base);
+        if (result.ec == std::errc::invalid_argument) {
+            return {first, result.ec};
+        }
+        if (result.ec != std::errc{}) {
+            return result;
         }
 
-        if (negative) {
-            result = -result;
+        // The magnitude of the minimum is the minimum itself reinterpreted as unsigned.
+        if (magnitude > (negative ? unsigned_t(min()) : unsigned_t(max()))) {
+            return {result.ptr, std::errc::result_out_of_range};
         }
+        value = negative ? -BigIntN(magnitude) : BigIntN(magnitude);
+        return result;
+    }
 
+    // Parses the whole string, throws std::invalid_argument if it is not a number in the base and std::out_of_range
+    // if the number does not fit. Use from_chars() to parse without exceptions.
+    static constexpr BigIntN from_string(std::string_view str, uint32_t base = 10) {
+        BigIntN result(0);
+        const auto [ptr, ec] = from_chars(str.data(), str.data() + str.size(), result, base);
+        if (ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("Number out of range");
+        }
+        if (ec != std::errc{} || ptr != str.data() + str.size()) {
+            throw std::invalid_argument("Invalid number");
+        }
         return result;
     }
 
@@ -485,11 +695,11 @@ public:
         long double result = 0;
         for (std::size_t i = 0; i < m_data.size(); ++i) {
             if (is_negative()) {
-                result += static_cast<long double>(static_cast<uint32_t>(~m_data[i])) *
-                          aba::pow<long double>(2.0, static_cast<long double>(32 * i));
+                result += static_cast<long double>(static_cast<data_t>(~m_data[i])) *
+                          aba::pow<long double>(2.0, static_cast<long double>(n_data_bits * i));
             } else {
-                result +=
-                    static_cast<long double>(m_data[i]) * aba::pow<long double>(2.0, static_cast<long double>(32 * i));
+                result += static_cast<long double>(m_data[i]) *
+                          aba::pow<long double>(2.0, static_cast<long double>(n_data_bits * i));
             }
         }
 
@@ -502,22 +712,186 @@ public:
 
     void dump() const {
         for (std::size_t i = 0; i < m_data.size(); ++i) {
-            std::cout << fmt::format("m_data[{}] = {:x} ({})", i, m_data[i], static_cast<int32_t>(m_data[i])) << '\n';
+            std::cout << fmt::format("m_data[{}] = {:x} ({})", i, m_data[i],
+                                     static_cast<std::make_signed_t<data_t>>(m_data[i]))
+                      << '\n';
         }
     }
 
     constexpr bool is_negative() const {
-        return m_data[3] > static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+        return m_data[data_size - 1] > static_cast<data_t>(std::numeric_limits<std::make_signed_t<data_t>>::max());
     }
 
 private:
-    friend class BigUInt;
+    using unsigned_t = BigUIntN<Limbs, Limb>;
+    friend class BigUIntN<Limbs, Limb>;
 
     std::array<data_t, data_size> m_data;
 };
 
-// TODO add formatting
+template <std::size_t Limbs, typename Limb>
+constexpr BigUIntN<Limbs, Limb>::BigUIntN(const BigIntN<Limbs, Limb>& value) : m_data(value.m_data) {}
+
+using BigUInt = BigUIntN<2>;
+using BigInt = BigIntN<2>;
+
+using BigUInt256 = BigUIntN<4>;
+using BigInt256 = BigIntN<4>;
+using BigUInt512 = BigUIntN<8>;
+using BigInt512 = BigIntN<8>;
+using BigUInt1024 = BigUIntN<16>;
+using BigInt1024 = BigIntN<16>;
+
+namespace detail {
+
+// Format specification of the fmt formatters, [[fill]align][sign]['#']['0'][width][grouping][type] as for the
+// built-in integers. The grouping ',' or '_' separates groups of three decimal or four binary, octal or hexadecimal
+// digits, and the types are 'd', 'x', 'X', 'b', 'B' and 'o'. Dynamic widths are not supported.
+struct IntegerFormatSpecs {
+    char fill = ' ';
+    char align = '\0';
+    char sign = '-';
+    bool alternate = false;
+    bool zero_pad = false;
+    std::size_t width = 0;
+    char separator = '\0';
+    char type = 'd';
+
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        auto it = ctx.begin();
+        const auto end = ctx.end();
+        const auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+        if (it != end && it + 1 != end && is_align(it[1]) && *it != '{' && *it != '}') {
+            fill = *it;
+            align = it[1];
+            it += 2;
+        } else if (it != end && is_align(*it)) {
+            align = *it++;
+        }
+        if (it != end && (*it == '+' || *it == '-' || *it == ' ')) {
+            sign = *it++;
+        }
+        if (it != end && *it == '#') {
+            alternate = true;
+            ++it;
+        }
+        if (it != end && *it == '0') {
+            zero_pad = true;
+            ++it;
+        }
+        for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+            width = width * 10 + static_cast<std::size_t>(*it - '0');
+        }
+        if (it != end && (*it == ',' || *it == '_')) {
+            separator = *it++;
+        }
+        if (it != end && std::string_view("dxXbBo").find(*it) != std::string_view::npos) {
+            type = *it++;
+        }
+        if (it != end && *it != '}') {
+            throw fmt::format_error("invalid format specifier");
+        }
+        return it;
+    }
+
+    constexpr uint32_t base() const {
+        switch (type) {
+        case 'x':
+        case 'X':
+            return 16;
+        case 'b':
+        case 'B':
+            return 2;
+        case 'o':
+            return 8;
+        default:
+            return 10;
+        }
+    }
+
+    // Writes the digits of magnitude, a BigUIntN, followed by suffix and padded to the width. The digits go straight
+    // to out through BigUIntN::for_each_digit().
+    template <typename Out, typename Unsigned>
+    constexpr Out write(Out out, bool negative, const Unsigned& magnitude, std::string_view suffix = {}) const {
+        const uint32_t base = this->base();
+        std::string_view prefix;
+        if (alternate && base != 10) {
+            prefix = std::string_view(type == 'x' ? "0x" : type == 'X' ? "0X" : type == 'b' ? "0b" : "0B");
+            if (base == 8) {
+                prefix = magnitude == Unsigned(0) ? "" : "0";
+            }
+        }
+        const char sign_char = negative ? '-' : sign == '-' ? '\0' : sign;
+        const uint32_t digits = magnitude.digits(base);
+        const uint32_t group = base == 10 ? 3 : 4;
+        const std::size_t size = (sign_char != '\0' ? 1 : 0) + prefix.size() + digits +
+                                 (separator != '\0' ? (digits - 1) / group : 0) + suffix.size();
+
+        const std::size_t padding = width > size ? width - size : 0;
+        std::size_t before = padding;
+        std::size_t zeros = 0;
+        if (align == '\0' && zero_pad) {
+            before = 0;
+            zeros = padding;
+        } else if (align == '<') {
+            before = 0;
+        } else if (align == '^') {
+            before = padding / 2;
+        }
+
+        out = std::fill_n(out, before, fill);
+        if (sign_char != '\0') {
+            *out++ = sign_char;
+        }
+        out = std::copy(prefix.begin(), prefix.end(), out);
+        out = std::fill_n(out, zeros, '0');
+        const std::string_view symbols = type == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+        uint32_t index = 0;
+        magnitude.for_each_digit(base, [&](uint32_t digit) {
+            if (separator != '\0' && index != 0 && (digits - index) % group == 0) {
+                *out++ = separator;
+            }
+            *out++ = symbols[digit];
+            ++index;
+        });
+        out = std::copy(suffix.begin(), suffix.end(), out);
+        return std::fill_n(out, padding - before - zeros, fill);
+    }
+};
 
-constexpr BigUInt::BigUInt(const BigInt& value) : m_data(value.m_data) {}
+} // namespace detail
 
 } // namespace aba
+
+template <std::size_t Limbs, typename Limb>
+struct fmt::formatter<aba::BigUIntN<Limbs, Limb>> {
+    aba::detail::IntegerFormatSpecs specs;
+
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        return specs.parse(ctx);
+    }
+
+    template <typename FormatContext>
+    auto format(const aba::BigUIntN<Limbs, Limb>& value, FormatContext& ctx) const {
+        return specs.write(ctx.out(), false, value);
+    }
+};
+
+template <std::size_t Limbs, typename Limb>
+struct fmt::formatter<aba::BigIntN<Limbs, Limb>> {
+    aba::detail::IntegerFormatSpecs specs;
+
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        return specs.parse(ctx);
+    }
+
+    // The magnitude of the minimum is the minimum itself reinterpreted as unsigned.
+    template <typename FormatContext>
+    auto format(const aba::BigIntN<Limbs, Limb>& value, FormatContext& ctx) const {
+        using unsigned_t = aba::BigUIntN<Limbs, Limb>;
+        return specs.write(ctx.out(), value.is_negative(), value.is_negative() ? unsigned_t(-value) : unsigned_t(value));
+    }
+};
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "big_int.hpp"
+#include "column_kernels.hpp"
+
+namespace aba {
+
+// A non-owning view of values stored as a structure of arrays, over a BigIntColumn or limb planes held elsewhere
+// (e.g. a mapped file). The batch operations below take their operands as views.
+template <typename T>
+class BigIntColumnView {
+public:
+    using value_t = T;
+    using limb_t = typename T::data_t;
+    static constexpr std::size_t n_limbs = T::data_size;
+    static constexpr bool is_signed = std::is_same_v<T, BigIntN<n_limbs, limb_t>>;
+
+    BigIntColumnView() = default;
+
+    // planes[j] points to limb j of size values.
+    BigIntColumnView(const std::array<const limb_t*, n_limbs>& planes, std::size_t size)
+        : m_planes(planes), m_size(size) {}
+
+    std::size_t size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    T operator[](std::size_t index) const {
+        std::array<limb_t, n_limbs> data{};
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            data[j] = m_planes[j][index];
+        }
+        return T(data);
+    }
+
+    std::vector<T> values() const {
+        std::vector<T> result;
+        result.reserve(m_size);
+        for (std::size_t i = 0; i < m_size; ++i) {
+            result.push_back((*this)[i]);
+        }
+        return result;
+    }
+
+    std::span<const limb_t> limbs(std::size_t j) const { return {m_planes[j], m_size}; }
+
+    const std::array<const limb_t*, n_limbs>& planes() const { return m_planes; }
+
+private:
+    std::array<const limb_t*, n_limbs> m_planes{};
+    std::size_t m_size = 0;
+};
+
+// Values of a BigUIntN or BigIntN type stored as a structure of arrays: limbs(j) holds limb j of every value, so that
+// the batch operations below can process several values at once in vector registers. Values are copied in and out.
+template <typename T>
+class BigIntColumn {
+public:
+    using value_t = T;
+    using limb_t = typename T::data_t;
+    static constexpr std::size_t n_limbs = T::data_size;
+    static constexpr bool is_signed = std::is_same_v<T, BigIntN<n_limbs, limb_t>>;
+
+    BigIntColumn() = default;
+
+    explicit BigIntColumn(std::size_t size) { resize(size); }
+
+    explicit BigIntColumn(std::span<const T> values) {
+        reserve(values.size());
+        for (const auto& value : values) {
+            push_back(value);
+        }
+    }
+
+    std::size_t size() const { return m_limbs[0].size(); }
+
+    bool empty() const { return size() == 0; }
+
+    // New values are zero.
+    void resize(std::size_t size) {
+        for (auto& limbs : m_limbs) {
+            limbs.resize(size);
+        }
+    }
+
+    void reserve(std::size_t capacity) {
+        for (auto& limbs : m_limbs) {
+            limbs.reserve(capacity);
+        }
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(const T& value) {
+        const auto data = limbs_of(value);
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            m_limbs[j].push_back(data[j]);
+        }
+    }
+
+    T operator[](std::size_t index) const { return view()[index]; }
+
+    void set(std::size_t index, const T& value) {
+        const auto data = limbs_of(value);
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            m_limbs[j][index] = data[j];
+        }
+    }
+
+    std::vector<T> values() const { return view().values(); }
+
+    // Limb j of every value.
+    std::span<limb_t> limbs(std::size_t j) { return m_limbs[j]; }
+    std::span<const limb_t> limbs(std::size_t j) const { return m_limbs[j]; }
+
+    // Pointers to the limb planes, as the kernels take them.
+    std::array<limb_t*, n_limbs> planes() {
+        std::array<limb_t*, n_limbs> result{};
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            result[j] = m_limbs[j].data();
+        }
+        return result;
+    }
+
+    std::array<const limb_t*, n_limbs> planes() const {
+        std::array<const limb_t*, n_limbs> result{};
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            result[j] = m_limbs[j].data();
+        }
+        return result;
+    }
+
+    BigIntColumnView<T> view() const { return {planes(), size()}; }
+
+    operator BigIntColumnView<T>() const { return view(); }
+
+private:
+    static std::array<limb_t, n_limbs> limbs_of(const T& value) {
+        const BigUIntN<n_limbs, limb_t> bits(value);
+        std::array<limb_t, n_limbs> data{};
+        std::copy(bits.limbs().begin(), bits.limbs().end(), data.begin());
+        return data;
+    }
+
+    std::array<std::vector<limb_t>, n_limbs> m_limbs;
+};
+
+namespace detail {
+
+template <typename T>
+void check_sizes(const BigIntColumnView<T>& lhs, const BigIntColumnView<T>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        throw std::invalid_argument("Columns must have the same size");
+    }
+}
+
+// Operands are views of the column type of result, which columns convert to.
+template <typename T>
+using column_view_t = std::type_identity_t<BigIntColumnView<T>>;
+
+} // namespace detail
+
+// The batch operations give the same values as the operators of T applied to each value, and result may be one of the
+// operands. Operands must have the same size, result is resized to it.
+
+// result[i] = lhs[i] + rhs[i]
+template <typename T>
+void add(BigIntColumn<T>& result, detail::column_view_t<T> lhs, detail::column_view_t<T> rhs) {
+    detail::check_sizes(lhs, rhs);
+    result.resize(lhs.size());
+    detail::columns::add(result.planes().data(), lhs.planes().data(), rhs.planes().data(), T::data_size, lhs.size());
+}
+
+// result[i] = lhs[i] - rhs[i]
+template <typename T>
+void sub(BigIntColumn<T>& result, detail::column_view_t<T> lhs, detail::column_view_t<T> rhs) {
+    detail::check_sizes(lhs, rhs);
+    result.resize(lhs.size());
+    detail::columns::sub(result.planes().data(), lhs.planes().data(), rhs.planes().data(), T::data_size, lhs.size());
+}
+
+// result[i] = value[i] * factor
+template <typename T>
+void multiply(BigIntColumn<T>& result, detail::column_view_t<T> value, typename T::data_t factor) {
+    result.resize(value.size());
+    detail::columns::mul_1(result.planes().data(), value.planes().data(), T::data_size, factor, value.size());
+}
+
+// result[i] is -1, 0 or 1 as lhs[i] <=> rhs[i], result must hold lhs.size() values.
+template <typename T>
+void compare(std::span<int8_t> result, const BigIntColumnView<T>& lhs, const BigIntColumnView<T>& rhs) {
+    detail::check_sizes(lhs, rhs);
+    if (result.size() < lhs.size()) {
+        throw std::invalid_argument("Result is too small");
+    }
+    detail::columns::compare(result.data(), lhs.planes().data(), rhs.planes().data(), T::data_size,
+                             BigIntColumnView<T>::is_signed, lhs.size());
+}
+
+template <typename T>
+void compare(std::span<int8_t> result, const BigIntColumn<T>& lhs, const BigIntColumn<T>& rhs) {
+    compare(result, lhs.view(), rhs.view());
+}
+
+// result[i] = value[i] << shift
+template <typename T>
+void shift_left(BigIntColumn<T>& result, detail::column_view_t<T> value, uint32_t shift) {
+    result.resize(value.size());
+    detail::columns::lshift(result.planes().data(), value.planes().data(), T::data_size, shift, value.size());
+}
+
+// result[i] = value[i] >> shift
+template <typename T>
+void shift_right(BigIntColumn<T>& result, detail::column_view_t<T> value, uint32_t shift) {
+    result.resize(value.size());
+    detail::columns::rshift(result.planes().data(), value.planes().data(), T::data_size, shift, value.size());
+}
+
+} // namespace aba
@@ -1,29 +1,513 @@
 #pragma once
 
+#include <bit>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include "big_int.hpp"
+#include "integer.hpp"
 
 namespace aba {
 
-constexpr BigInt root(const BigInt& value, int32_t n) {
-    if (value == 0) {
-        return BigInt(0);
+namespace detail {
+
+// lhs * rhs if it does not exceed limit, nullopt otherwise. The product is only formed when it has fewer bits than
+// limit, so it can not overflow a fixed width type.
+template <typename T>
+constexpr std::optional<T> mul_bounded(const T& lhs, const T& rhs, const T& limit) {
+    const std::size_t bits = lhs.bit_length() + rhs.bit_length();
+    const std::size_t limit_bits = limit.bit_length();
+    if (bits <= limit_bits) {
+        const T product = lhs * rhs;
+        return product <= limit ? std::optional<T>(product) : std::nullopt;
     }
+    // lhs * rhs >= 2^(bits - 2) > limit, unless it has just one bit more than limit.
+    if (bits > limit_bits + 1 || lhs > limit / rhs) {
+        return std::nullopt;
+    }
+    return lhs * rhs;
+}
 
-    // Newton–Raphson method (find roots/solutions for f(x) = x^n - value = 0) by
-    // calculating x_n+1 = x_n - f(x_n)/f'(x_n) until x_n+1 >= x_n.
-    // f(x)/f'(x) = (x^n - value) / (n*x^(n-1)) = x/n - value/(n*x^(n-1))
-    BigInt x_n = value / value.digits(n) + 1;
+// value^exponent by square and multiply if it does not exceed limit, nullopt otherwise.
+template <typename T>
+constexpr std::optional<T> pow_bounded(const T& value, uint32_t exponent, const T& limit) {
+    T result(1);
+    T square = value;
     while (true) {
-        auto next = x_n - x_n / n + value / (n * aba::BigInt::pow(x_n, n - 1));
-        if (next >= x_n) {
-            break;
+        if ((exponent & 1) != 0) {
+            const auto product = mul_bounded(result, square, limit);
+            if (!product) {
+                return std::nullopt;
+            }
+            result = *product;
         }
-        x_n = next;
+        exponent = exponent >> 1;
+        if (exponent == 0) {
+            return result;
+        }
+        const auto product = mul_bounded(square, square, limit);
+        if (!product) {
+            return std::nullopt;
+        }
+        square = *product;
     }
+}
+
+// Newton's iteration x' = ((n - 1) * x + value / x^(n - 1)) / n for the n-th root of f(x) = x^n - value. Started
+// above the root the iterates decrease monotonically to floor(value^(1/n)), the first one which does not decrease
+// is the result. 2^ceil(bits / n) is above the root and less than twice it, so the iteration converges quadratically
+// from the first step.
+template <typename T>
+constexpr T root_newton(const T& value, uint32_t n) {
+    const std::size_t bits = value.bit_length();
+    T x = T(1) << static_cast<uint32_t>((bits + n - 1) / n);
+    while (true) {
+        T next = x * T(n - 1);
+        if (const auto power = pow_bounded(x, n - 1, value)) {
+            next += value / *power;
+        }
+        next = next / T(n);
+        if (next >= x) {
+            return x;
+        }
+        x = next;
+    }
+}
+
+// Karatsuba square root (P. Zimmermann, "Karatsuba Square Root", 1999). value = a3 b^3 + a2 b^2 + a1 b + a0 with
+// b = 2^k and a3 >= b / 4: the root s' of the upper half gives the upper half of the root, the lower half comes from
+// dividing the remainder r' by 2 s'. This costs about as much as a single division of half the size, where Newton's
+// iteration does several full divisions.
+template <typename T>
+std::pair<T, T> sqrt_rem_karatsuba(const T& value);
+
+template <typename T>
+std::pair<T, T> sqrt_rem_normalized(const T& value, uint32_t k) {
+    const T high = value >> (2 * k);
+    T a1 = value >> k;
+    T a0 = value;
+    a0 -= a1 << k;
+    a1 -= high << k;
 
-    return x_n;
+    const auto [s1, r1] = sqrt_rem_karatsuba(high);
+    T numerator = r1 << k;
+    numerator += a1;
+    const auto [q, u] = T::division(numerator, s1 << 1);
+    T root = s1 << k;
+    root += q;
+    T remainder = u << k;
+    remainder += a0;
+    const T q_squared = q * q;
+    if (remainder < q_squared) {
+        // The estimate q was one too large: (root - 1)^2 = root^2 - 2 root + 1.
+        remainder += root << 1;
+        remainder -= T(1);
+        root -= T(1);
+    }
+    remainder -= q_squared;
+    return {root, remainder};
+}
+
+template <typename T>
+std::pair<T, T> sqrt_rem_karatsuba(const T& value) {
+    constexpr std::size_t basecase_bits = 256;
+
+    const std::size_t bits = value.bit_length();
+    if (bits <= basecase_bits) {
+        const T root = root_newton(value, 2);
+        return {root, value - root * root};
+    }
+
+    // Scale by an even power of two to 4k - 1 or 4k bits, which makes a3 >= b / 4, and scale the root back.
+    const auto k = static_cast<uint32_t>((bits + 3) / 4);
+    const auto shift = static_cast<uint32_t>((4 * k - bits) / 2);
+    if (shift == 0) {
+        return sqrt_rem_normalized(value, k);
+    }
+    const T root = sqrt_rem_normalized(value << (2 * shift), k).first >> shift;
+    return {root, value - root * root};
+}
+
+} // namespace detail
+
+// Integer n-th root (rounded down) of a non-negative value and the remainder value - root^n, for BigIntN, BigUIntN
+// as well as Integer.
+template <typename T>
+constexpr std::pair<T, T> root_rem(const T& value, int32_t n) {
+    if (n < 1) {
+        throw std::invalid_argument("Root degree must be positive");
+    }
+    if (n == 1 || value <= T(1)) {
+        return {value, T(0)};
+    }
+
+    // value < 2^bits <= 2^n, the root is 1.
+    if (value.bit_length() <= static_cast<std::size_t>(n)) {
+        return {T(1), value - T(1)};
+    }
+
+    if constexpr (std::is_same_v<T, Integer>) {
+        if (n == 2) {
+            return detail::sqrt_rem_karatsuba(value);
+        }
+    }
+
+    const T root = detail::root_newton(value, static_cast<uint32_t>(n));
+    return {root, value - T::pow(root, static_cast<uint32_t>(n))};
+}
+
+template <typename T>
+constexpr T root(const T& value, int32_t n) {
+    return root_rem(value, n).first;
+}
+
+template <typename T>
+constexpr std::pair<T, T> sqrt_rem(const T& value) {
+    return root_rem(value, 2);
+}
+
+template <typename T>
+constexpr T sqrt(const T& value) {
+    return root(value, 2);
+}
+
+// True if the non-negative value is a^k for some integers a and k >= 2, which includes 0 and 1. Only prime k up to the
+// bit length need to be tried.
+template <typename T>
+constexpr bool is_perfect_power(const T& value) {
+    if (value <= T(1)) {
+        return true;
+    }
+
+    const std::size_t bits = value.bit_length();
+    for (uint32_t k = 2; k < bits; ++k) {
+        bool prime = true;
+        for (uint32_t d = 2; d * d <= k; ++d) {
+            prime = prime && k % d != 0;
+        }
+        if (prime && root_rem(value, static_cast<int32_t>(k)).second == T(0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace detail {
+
+// The gcd functions work on the magnitudes, BigIntN in the unsigned type of the same width (the magnitude of the
+// minimum does not fit the signed one).
+template <typename T>
+struct Magnitude {
+    using type = T;
 };
 
-constexpr BigInt sqrt(const BigInt& value) { return root(value, 2); };
+template <std::size_t Limbs, typename Limb>
+struct Magnitude<BigIntN<Limbs, Limb>> {
+    using type = BigUIntN<Limbs, Limb>;
+};
+
+template <typename T>
+using magnitude_t = typename Magnitude<T>::type;
+
+template <typename T>
+constexpr magnitude_t<T> magnitude(const T& value) {
+    if constexpr (std::is_same_v<T, Integer> || !std::is_same_v<T, magnitude_t<T>>) {
+        return value < T(0) ? magnitude_t<T>(-value) : magnitude_t<T>(value);
+    } else {
+        return value;
+    }
+}
+
+// The value of a word.
+template <typename U>
+constexpr U from_word(uint64_t value) {
+    if constexpr (std::is_same_v<U, Integer>) {
+        return Integer::from_limbs(std::span<const uint64_t>(&value, 1));
+    } else {
+        return U(value);
+    }
+}
+
+// The low 64 bits of a magnitude.
+template <std::size_t Limbs, typename Limb>
+constexpr uint64_t low_word(const BigUIntN<Limbs, Limb>& value) {
+    if constexpr (std::is_same_v<Limb, uint32_t>) {
+        return value.limbs()[0] | (static_cast<uint64_t>(value.limbs()[1]) << 32);
+    } else {
+        return value.limbs()[0];
+    }
+}
+
+inline uint64_t low_word(const Integer& value) { return value.limbs().empty() ? 0 : value.limbs()[0]; }
+
+// Stein's binary gcd: shifts and subtractions only.
+constexpr uint64_t binary_gcd(uint64_t lhs, uint64_t rhs) {
+    if (lhs == 0 || rhs == 0) {
+        return lhs | rhs;
+    }
+    const int shift = std::countr_zero(lhs | rhs);
+    lhs >>= std::countr_zero(lhs);
+    do {
+        rhs >>= std::countr_zero(rhs);
+        if (lhs > rhs) {
+            std::swap(lhs, rhs);
+        }
+        rhs -= lhs;
+    } while (rhs != 0);
+    return lhs << shift;
+}
+
+// The reduction (a, b) -> (a', b') of the gcd functions as the matrix with (a, b) = M (a', b'). Its entries are
+// non-negative and its determinant is -1 if negative is set, +1 otherwise.
+template <typename U>
+struct Cofactors {
+    U m00 = U(1);
+    U m01 = U(0);
+    U m10 = U(0);
+    U m11 = U(1);
+    bool negative = false;
+
+    // M = M N
+    constexpr void multiply(const U& n00, const U& n01, const U& n10, const U& n11, bool n_negative) {
+        U r00 = m00 * n00;
+        r00 += m01 * n10;
+        U r01 = m00 * n01;
+        r01 += m01 * n11;
+        U r10 = m10 * n00;
+        r10 += m11 * n10;
+        U r11 = m10 * n01;
+        r11 += m11 * n11;
+        m00 = std::move(r00);
+        m01 = std::move(r01);
+        m10 = std::move(r10);
+        m11 = std::move(r11);
+        negative = negative != n_negative;
+    }
+};
+
+// One Euclidean step (a, b) -> (b, a mod b).
+template <typename U>
+constexpr void division_step(U& a, U& b, Cofactors<U>* cofactors) {
+    auto [quotient, remainder] = U::division(a, b);
+    if (cofactors != nullptr) {
+        cofactors->multiply(quotient, U(1), U(1), U(0), true);
+    }
+    a = std::move(b);
+    b = std::move(remainder);
+}
+
+// One step of Lehmer's algorithm (Knuth, TAOCP 4.5.2, algorithm L) for a >= b > 0: the quotients of the leading 62
+// bits of a and b which are certain to be quotients of a and b as well are found in single word arithmetic, and
+// applied to a and b at once. If there are none (the leading bits of b are zero, or the first quotient is uncertain)
+// it takes a division step instead.
+template <typename U>
+constexpr void lehmer_step(U& a, U& b, Cofactors<U>* cofactors) {
+    const std::size_t bits = a.bit_length();
+    const auto shift = static_cast<uint32_t>(bits > 62 ? bits - 62 : 0);
+    auto x = static_cast<int64_t>(low_word(a >> shift));
+    auto y = static_cast<int64_t>(low_word(b >> shift));
+
+    // (a', b') = (u0 a + v0 b, u1 a + v1 b), the signs alternate with the number of steps.
+    int64_t u0 = 1;
+    int64_t v0 = 0;
+    int64_t u1 = 0;
+    int64_t v1 = 1;
+    bool odd = false;
+    while (y + u1 != 0 && y + v1 != 0) {
+        const int64_t q = (x + u0) / (y + u1);
+        if (q != (x + v0) / (y + v1)) {
+            break;
+        }
+        std::tie(u0, u1) = std::pair(u1, u0 - q * u1);
+        std::tie(v0, v1) = std::pair(v1, v0 - q * v1);
+        std::tie(x, y) = std::pair(y, x - q * y);
+        odd = !odd;
+    }
+
+    if (v0 == 0) {
+        division_step(a, b, cofactors);
+        return;
+    }
+
+    const U abs_u0 = from_word<U>(static_cast<uint64_t>(u0 < 0 ? -u0 : u0));
+    const U abs_v0 = from_word<U>(static_cast<uint64_t>(v0 < 0 ? -v0 : v0));
+    const U abs_u1 = from_word<U>(static_cast<uint64_t>(u1 < 0 ? -u1 : u1));
+    const U abs_v1 = from_word<U>(static_cast<uint64_t>(v1 < 0 ? -v1 : v1));
+    U next_a = odd ? b * abs_v0 : a * abs_u0;
+    next_a -= odd ? a * abs_u0 : b * abs_v0;
+    U next_b = odd ? a * abs_u1 : b * abs_v1;
+    next_b -= odd ? b * abs_v1 : a * abs_u1;
+    a = std::move(next_a);
+    b = std::move(next_b);
+    if (cofactors != nullptr) {
+        cofactors->multiply(abs_v1, abs_v0, abs_u1, abs_u0, odd);
+    }
+}
+
+// Reductions of at least this many bits use the recursion on the leading bits in reduce().
+inline constexpr std::size_t half_gcd_threshold = 64 * 64;
+
+// Applies the cofactors found for the leading bits of a and b to the full values, (a, b) = M^-1 (a, b). Fails and
+// leaves a and b alone unless the result is a valid reduction a > b >= 0, which it almost always is.
+inline bool apply_cofactors(Integer& a, Integer& b, const Cofactors<Integer>& cofactors) {
+    Integer next_a = cofactors.m11 * a;
+    next_a -= cofactors.m01 * b;
+    Integer next_b = cofactors.m00 * b;
+    next_b -= cofactors.m10 * a;
+    if (cofactors.negative) {
+        next_a = -next_a;
+        next_b = -next_b;
+    }
+    if (next_b < Integer(0) || next_a <= next_b) {
+        return false;
+    }
+    a = std::move(next_a);
+    b = std::move(next_b);
+    return true;
+}
+
+// Reduces a >= b >= 0 by Euclidean steps until b has at most target_bits bits (b = 0 and a = gcd for a target of 0),
+// accumulating the steps in cofactors if given.
+//
+// Long Integer reductions follow the half gcd idea: the quotients of a reduction by d bits are those of the leading
+// 2d bits only (plus a margin), so they are found recursively on those, and applied to the full values with a few
+// multiplications. A reduction by more than half the length is split in two halves first.
+template <typename U>
+constexpr void reduce(U& a, U& b, std::size_t target_bits, Cofactors<U>* cofactors) {
+    constexpr std::size_t margin = 64;
+
+    while (b.bit_length() > target_bits) {
+        const std::size_t bits = a.bit_length();
+        if constexpr (std::is_same_v<U, Integer>) {
+            const std::size_t reduction = bits - target_bits;
+            if (reduction >= half_gcd_threshold) {
+                if (2 * target_bits < bits + margin + half_gcd_threshold) {
+                    // Once b is below the halfway point, e.g. for operands of very different lengths, the next step
+                    // is a single long division.
+                    const std::size_t halfway_bits = bits - reduction / 2;
+                    if (b.bit_length() > halfway_bits) {
+                        reduce(a, b, halfway_bits, cofactors);
+                        continue;
+                    }
+                } else {
+                    const auto shift = static_cast<uint32_t>(2 * target_bits - bits - margin);
+                    Integer high_a = a >> shift;
+                    Integer high_b = b >> shift;
+                    Cofactors<Integer> step;
+                    reduce(high_a, high_b, target_bits - shift, &step);
+                    if (step.m01 != Integer(0) && apply_cofactors(a, b, step)) {
+                        if (cofactors != nullptr) {
+                            cofactors->multiply(step.m00, step.m01, step.m10, step.m11, step.negative);
+                        }
+                        continue;
+                    }
+                }
+            }
+        }
+
+        if (cofactors == nullptr && bits <= 64) {
+            a = from_word<U>(binary_gcd(low_word(a), low_word(b)));
+            b = U(0);
+            return;
+        }
+        lehmer_step(a, b, cofactors);
+    }
+}
+
+template <typename U>
+constexpr U gcd_magnitude(U a, U b) {
+    if (a < b) {
+        std::swap(a, b);
+    }
+    reduce<U>(a, b, 0, nullptr);
+    return a;
+}
+
+} // namespace detail
+
+// Greatest common divisor of the magnitudes, gcd(0, 0) = 0. Lehmer's algorithm, with a half gcd recursion for long
+// Integers. For BigIntN, gcd(min(), min()) and gcd(min(), 0) are 2^(n_bits - 1), which wraps around to min().
+template <typename T>
+constexpr T gcd(const T& lhs, const T& rhs) {
+    return T(detail::gcd_magnitude(detail::magnitude(lhs), detail::magnitude(rhs)));
+}
+
+// Least common multiple of the magnitudes, 0 if either is 0.
+template <typename T>
+constexpr T lcm(const T& lhs, const T& rhs) {
+    if (lhs == T(0) || rhs == T(0)) {
+        return T(0);
+    }
+    const auto a = detail::magnitude(lhs);
+    const auto b = detail::magnitude(rhs);
+    return T(a / detail::gcd_magnitude(a, b) * b);
+}
+
+// Extended gcd: {g, s, t} with g = gcd(lhs, rhs) = s lhs + t rhs, and |s| <= |rhs| / g and |t| <= |lhs| / g if neither
+// is 0. For BigUIntN the cofactors are two's complement, i.e. the identity holds modulo 2^n_bits.
+template <typename T>
+constexpr std::tuple<T, T, T> xgcd(const T& lhs, const T& rhs) {
+    using U = detail::magnitude_t<T>;
+    U a = detail::magnitude(lhs);
+    U b = detail::magnitude(rhs);
+    const bool swapped = a < b;
+    if (swapped) {
+        std::swap(a, b);
+    }
+
+    // (a0, b0) = M (g, 0), so g = det(M) (m11 a0 - m01 b0).
+    detail::Cofactors<U> cofactors;
+    detail::reduce(a, b, 0, &cofactors);
+    T s = T(cofactors.m11);
+    T t = -T(cofactors.m01);
+    if (cofactors.negative) {
+        s = -s;
+        t = -t;
+    }
+    if (swapped) {
+        std::swap(s, t);
+    }
+    if (lhs < T(0)) {
+        s = -s;
+    }
+    if (rhs < T(0)) {
+        t = -t;
+    }
+    return {T(a), s, t};
+}
+
+// The inverse of value modulo modulus > 0, in [0, modulus). Throws std::invalid_argument if the modulus is not
+// positive or the value is not invertible, i.e. not coprime to the modulus.
+template <typename T>
+constexpr T modinv(const T& value, const T& modulus) {
+    using U = detail::magnitude_t<T>;
+    if (modulus <= T(0)) {
+        throw std::invalid_argument("Modulus must be positive");
+    }
+
+    T reduced = value % modulus;
+    if (reduced < T(0)) {
+        reduced += modulus;
+    }
+    U a = detail::magnitude(modulus);
+    U b = detail::magnitude(reduced);
+
+    // (m, r) = M (1, 0) gives 1 = det(M) (m11 m - m01 r), so r^-1 = -det(M) m01 mod m.
+    detail::Cofactors<U> cofactors;
+    detail::reduce(a, b, 0, &cofactors);
+    if (a != U(1)) {
+        throw std::invalid_argument("Value is not invertible");
+    }
+    const U m = detail::magnitude(modulus);
+    const U inverse = cofactors.m01 % m;
+    if (cofactors.negative || inverse == U(0)) {
+        return T(inverse);
+    }
+    return T(m - inverse);
+}
 
 } // namespace aba
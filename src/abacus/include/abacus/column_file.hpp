@@ -0,0 +1,332 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ABACUS_MMAP 1
+#else
+#define ABACUS_MMAP 0
+#endif
+
+#include "big_int.hpp"
+#include "big_int_column.hpp"
+
+namespace aba {
+
+// How the limbs of the values follow each other in a column file.
+enum class ColumnLayout : uint32_t {
+    rows = 0,    // value after value, the in-memory layout of BigUIntN and BigIntN
+    columns = 1, // limb j of every value in plane j, the layout of BigIntColumn
+};
+
+// The header at the start of a column file, followed by the limbs of the values at payload_offset. The payload and
+// every plane start at a multiple of column_file_alignment. Fields and limbs are little endian.
+struct ColumnFileHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t limb_bits;
+    uint64_t limbs; // per value
+    uint64_t count;
+    ColumnLayout layout;
+    uint32_t is_signed;
+    uint64_t payload_offset;
+    uint64_t plane_stride; // bytes from one plane to the next, zero in the row layout
+    uint64_t reserved;
+};
+static_assert(sizeof(ColumnFileHeader) == 64);
+
+inline constexpr std::array<char, 8> column_file_magic = {'A', 'B', 'A', 'C', 'O', 'L', '\0', '\0'};
+inline constexpr uint32_t column_file_version = 1;
+// A cache line, and the widest vectors of the column kernels.
+inline constexpr std::size_t column_file_alignment = 64;
+
+namespace detail {
+
+constexpr uint64_t align_up(uint64_t bytes) {
+    return (bytes + column_file_alignment - 1) / column_file_alignment * column_file_alignment;
+}
+
+template <typename T>
+constexpr ColumnFileHeader column_file_header(ColumnLayout layout, uint64_t count) {
+    using limb_t = typename T::data_t;
+    ColumnFileHeader header{};
+    header.magic = column_file_magic;
+    header.version = column_file_version;
+    header.limb_bits = std::numeric_limits<limb_t>::digits;
+    header.limbs = T::data_size;
+    header.count = count;
+    header.layout = layout;
+    header.is_signed = BigIntColumnView<T>::is_signed ? 1 : 0;
+    header.payload_offset = align_up(sizeof(ColumnFileHeader));
+    header.plane_stride = layout == ColumnLayout::columns ? align_up(count * sizeof(limb_t)) : 0;
+    return header;
+}
+
+} // namespace detail
+
+// Writes a column file value by value, holding at most a chunk of them in memory. The row layout is written as the
+// values come and gets its count when closed. The column layout places each plane by the count, which must be given
+// up front, and writes the planes a chunk at a time.
+template <typename T>
+class ColumnFileWriter {
+public:
+    using value_t = T;
+    using limb_t = typename T::data_t;
+    static constexpr std::size_t n_limbs = T::data_size;
+    static_assert(std::endian::native == std::endian::little, "Column files are little endian");
+
+    explicit ColumnFileWriter(const std::filesystem::path& path, ColumnLayout layout = ColumnLayout::rows,
+                              std::optional<uint64_t> count = std::nullopt)
+        : m_path(path), m_header(detail::column_file_header<T>(layout, count.value_or(0))), m_count(count) {
+        if (layout == ColumnLayout::columns && !count) {
+            throw std::invalid_argument("The column layout must be given a count");
+        }
+        m_file.exceptions(std::ios::failbit | std::ios::badbit);
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        write_header();
+    }
+
+    ColumnFileWriter(const ColumnFileWriter&) = delete;
+    ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+
+    // Like an ofstream, a file not closed explicitly is closed here and errors are lost.
+    ~ColumnFileWriter() {
+        if (m_file.is_open()) {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+    }
+
+    void write(const T& value) {
+        if (m_count && m_written == *m_count) {
+            throw std::out_of_range("Column file already has all its values");
+        }
+        const BigUIntN<n_limbs, limb_t> bits(value);
+        if (m_header.layout == ColumnLayout::rows) {
+            m_file.write(reinterpret_cast<const char*>(bits.limbs().data()),
+                         static_cast<std::streamsize>(sizeof(limb_t) * n_limbs));
+        } else {
+            for (std::size_t j = 0; j < n_limbs; ++j) {
+                m_chunk[j].push_back(bits.limbs()[j]);
+            }
+        }
+        ++m_written;
+        if (m_chunk[0].size() == chunk_size) {
+            write_chunk();
+        }
+    }
+
+    void write(std::span<const T> values) {
+        for (const auto& value : values) {
+            write(value);
+        }
+    }
+
+    uint64_t size() const { return m_written; }
+
+    void close() {
+        if (m_count && m_written != *m_count) {
+            m_file.close();
+            throw std::runtime_error("Column file must get as many values as its count");
+        }
+        write_chunk();
+        m_header.count = m_written;
+        m_file.seekp(0);
+        write_header();
+        m_file.close();
+        if (m_header.layout == ColumnLayout::columns) {
+            // Pads the last plane, which the chunks only wrote up to its last value.
+            std::filesystem::resize_file(m_path, m_header.payload_offset + n_limbs * m_header.plane_stride);
+        }
+    }
+
+private:
+    static constexpr std::size_t chunk_size = 4096;
+
+    void write_header() {
+        m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+        const std::array<char, column_file_alignment> padding{};
+        m_file.write(padding.data(), static_cast<std::streamsize>(m_header.payload_offset - sizeof(m_header)));
+    }
+
+    void write_chunk() {
+        if (m_chunk[0].empty()) {
+            return;
+        }
+        const uint64_t offset = m_header.payload_offset + (m_written - m_chunk[0].size()) * sizeof(limb_t);
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            m_file.seekp(static_cast<std::streamoff>(offset + j * m_header.plane_stride));
+            m_file.write(reinterpret_cast<const char*>(m_chunk[j].data()),
+                         static_cast<std::streamsize>(m_chunk[j].size() * sizeof(limb_t)));
+            m_chunk[j].clear();
+        }
+    }
+
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    ColumnFileHeader m_header;
+    std::optional<uint64_t> m_count;
+    uint64_t m_written = 0;
+    // Values of the column layout not yet written, by plane.
+    std::array<std::vector<limb_t>, n_limbs> m_chunk;
+};
+
+#if ABACUS_MMAP
+
+// A column file mapped read-only into memory, with the values read where they are: opening it parses and copies
+// nothing, and pages are loaded as they are first touched.
+template <typename T>
+class MappedColumnFile {
+public:
+    using value_t = T;
+    using limb_t = typename T::data_t;
+    static constexpr std::size_t n_limbs = T::data_size;
+    static_assert(std::endian::native == std::endian::little, "Column files are little endian");
+    // Values of the row layout are used in place, so they must be exactly their limbs.
+    static_assert(sizeof(T) == sizeof(limb_t) * n_limbs && std::is_trivially_copyable_v<T> &&
+                  std::is_standard_layout_v<T>);
+
+    explicit MappedColumnFile(const std::filesystem::path& path) {
+        const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) {
+            throw std::system_error(errno, std::generic_category(), "Could not open " + path.string());
+        }
+        struct stat status {};
+        if (::fstat(file, &status) != 0) {
+            const int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), "Could not read " + path.string());
+        }
+        if (static_cast<uint64_t>(status.st_size) < sizeof(ColumnFileHeader)) {
+            ::close(file);
+            throw std::runtime_error("Not a column file");
+        }
+        m_length = static_cast<std::size_t>(status.st_size);
+        void* data = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, file, 0);
+        const int error = errno;
+        // The mapping keeps the file open.
+        ::close(file);
+        if (data == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Could not map " + path.string());
+        }
+        m_data = static_cast<const std::byte*>(data);
+        std::memcpy(&m_header, m_data, sizeof(m_header));
+        try {
+            check_header();
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    MappedColumnFile(MappedColumnFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_length(std::exchange(other.m_length, 0)),
+          m_header(other.m_header) {}
+
+    MappedColumnFile& operator=(MappedColumnFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_length = std::exchange(other.m_length, 0);
+            m_header = other.m_header;
+        }
+        return *this;
+    }
+
+    ~MappedColumnFile() { unmap(); }
+
+    const ColumnFileHeader& header() const { return m_header; }
+
+    ColumnLayout layout() const { return m_header.layout; }
+
+    std::size_t size() const { return static_cast<std::size_t>(m_header.count); }
+
+    // The values of a file in the row layout.
+    std::span<const T> values() const {
+        if (layout() != ColumnLayout::rows) {
+            throw std::runtime_error("Column file is not in the row layout");
+        }
+        return {reinterpret_cast<const T*>(payload()), size()};
+    }
+
+    // The planes of a file in the column layout, for the batch operations of BigIntColumn.
+    BigIntColumnView<T> column() const {
+        if (layout() != ColumnLayout::columns) {
+            throw std::runtime_error("Column file is not in the column layout");
+        }
+        std::array<const limb_t*, n_limbs> planes{};
+        for (std::size_t j = 0; j < n_limbs; ++j) {
+            planes[j] = reinterpret_cast<const limb_t*>(payload() + j * m_header.plane_stride);
+        }
+        return {planes, size()};
+    }
+
+    T operator[](std::size_t index) const {
+        return layout() == ColumnLayout::rows ? values()[index] : column()[index];
+    }
+
+private:
+    const std::byte* payload() const { return m_data + m_header.payload_offset; }
+
+    void check_header() const {
+        const auto expected = detail::column_file_header<T>(m_header.layout, m_header.count);
+        if (m_header.magic != column_file_magic || m_header.version != column_file_version ||
+            (m_header.layout != ColumnLayout::rows && m_header.layout != ColumnLayout::columns) ||
+            m_header.payload_offset != expected.payload_offset) {
+            throw std::runtime_error("Not a column file");
+        }
+        if (m_header.limb_bits != expected.limb_bits || m_header.limbs != expected.limbs ||
+            m_header.is_signed != expected.is_signed) {
+            throw std::runtime_error("Column file does not hold values of this type");
+        }
+        // Bounded first so that the sizes below cannot overflow.
+        if (m_header.count > m_length / (sizeof(limb_t) * n_limbs)) {
+            throw std::runtime_error("Column file is truncated");
+        }
+        if (m_header.plane_stride != expected.plane_stride) {
+            throw std::runtime_error("Not a column file");
+        }
+        const uint64_t payload = layout() == ColumnLayout::rows ? m_header.count * sizeof(T)
+                                                                : n_limbs * m_header.plane_stride;
+        if (m_header.payload_offset + payload > m_length) {
+            throw std::runtime_error("Column file is truncated");
+        }
+    }
+
+    void unmap() {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<std::byte*>(m_data), m_length);
+            m_data = nullptr;
+        }
+    }
+
+    const std::byte* m_data = nullptr;
+    std::size_t m_length = 0;
+    ColumnFileHeader m_header{};
+};
+
+#endif
+
+} // namespace aba
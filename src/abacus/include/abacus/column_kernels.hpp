@@ -0,0 +1,570 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "cpu.hpp"
+#include "limb.hpp"
+
+// Kernels on columns of values stored as limb planes: plane j holds limb j of every value, the values are processed in
+// the index range [begin, end). Each kernel applies the operation of BigUIntN to every value on its own, so the vector
+// variants put one value in each lane and run the limbs as a loop over the planes.
+//
+// The scalar kernels work for both limb types, the vector ones for 64-bit limbs and are chosen at runtime for the CPU
+// (see simd_kernels()). Results may be stored over the operands, plane by plane.
+namespace aba::detail::columns {
+
+namespace scalar {
+
+template <typename Limb>
+void add(Limb* const* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, std::size_t begin,
+         std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Limb carry = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            result[j][i] = add_carry(lhs[j][i], rhs[j][i], carry);
+        }
+    }
+}
+
+template <typename Limb>
+void sub(Limb* const* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, std::size_t begin,
+         std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Limb borrow = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            result[j][i] = sub_borrow(lhs[j][i], rhs[j][i], borrow);
+        }
+    }
+}
+
+template <typename Limb>
+void mul_1(Limb* const* result, const Limb* const* value, std::size_t limbs, Limb factor, std::size_t begin,
+           std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Limb carry = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const auto [low, high] = mul_wide(value[j][i], factor);
+            Limb overflow = 0;
+            result[j][i] = add_carry(low, carry, overflow);
+            carry = static_cast<Limb>(high + overflow);
+        }
+    }
+}
+
+// result[i] is -1, 0 or 1 as lhs <=> rhs, with the top limb compared as two's complement if is_signed.
+template <typename Limb>
+void compare(int8_t* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, bool is_signed,
+             std::size_t begin, std::size_t end) {
+    const Limb sign = is_signed ? Limb{1} << (limb_bits<Limb> - 1) : Limb{0};
+    for (std::size_t i = begin; i < end; ++i) {
+        int8_t order = 0;
+        for (std::size_t j = limbs; j > 0; --j) {
+            const Limb flip = j == limbs ? sign : Limb{0};
+            const auto a = static_cast<Limb>(lhs[j - 1][i] ^ flip);
+            const auto b = static_cast<Limb>(rhs[j - 1][i] ^ flip);
+            if (a != b) {
+                order = a < b ? -1 : 1;
+                break;
+            }
+        }
+        result[i] = order;
+    }
+}
+
+// value << shift, shifts of the full width or more give zero.
+template <typename Limb>
+void lshift(Limb* const* result, const Limb* const* value, std::size_t limbs, uint32_t shift, std::size_t begin,
+            std::size_t end) {
+    constexpr uint32_t bits = limb_bits<Limb>;
+    const std::size_t offset = shift / bits;
+    const uint32_t bit = shift % bits;
+    // From the top plane down, which only reads the planes below.
+    for (std::size_t j = limbs; j > 0; --j) {
+        const std::size_t k = j - 1;
+        for (std::size_t i = begin; i < end; ++i) {
+            Limb limb = 0;
+            if (k >= offset) {
+                limb = static_cast<Limb>(value[k - offset][i] << bit);
+                if (bit != 0 && k > offset) {
+                    limb |= static_cast<Limb>(value[k - offset - 1][i] >> (bits - bit));
+                }
+            }
+            result[k][i] = limb;
+        }
+    }
+}
+
+// value >> shift, shifts of the full width or more give zero.
+template <typename Limb>
+void rshift(Limb* const* result, const Limb* const* value, std::size_t limbs, uint32_t shift, std::size_t begin,
+            std::size_t end) {
+    constexpr uint32_t bits = limb_bits<Limb>;
+    const std::size_t offset = shift / bits;
+    const uint32_t bit = shift % bits;
+    // From the bottom plane up, which only reads the planes above.
+    for (std::size_t k = 0; k < limbs; ++k) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Limb limb = 0;
+            if (k + offset < limbs) {
+                limb = static_cast<Limb>(value[k + offset][i] >> bit);
+                if (bit != 0 && k + offset + 1 < limbs) {
+                    limb |= static_cast<Limb>(value[k + offset + 1][i] << (bits - bit));
+                }
+            }
+            result[k][i] = limb;
+        }
+    }
+}
+
+} // namespace scalar
+
+#if ABACUS_X86_KERNELS
+// Four values at a time. AVX2 has no unsigned comparisons, they are signed ones with the top bits flipped, and the
+// carries are masks of all ones. The 64 by 64 bit products are put together from four 32 by 32 bit ones.
+namespace avx2 {
+
+constexpr std::size_t lanes = 4;
+
+#define ABACUS_AVX2 __attribute__((target("avx2")))
+
+ABACUS_AVX2 inline __m256i load(const uint64_t* data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+ABACUS_AVX2 inline void store(uint64_t* data, __m256i value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+}
+
+// All ones in the lanes where lhs < rhs as unsigned numbers.
+ABACUS_AVX2 inline __m256i less(__m256i lhs, __m256i rhs) {
+    const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(rhs, sign), _mm256_xor_si256(lhs, sign));
+}
+
+ABACUS_AVX2 inline void add(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                            std::size_t limbs, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m256i zero = _mm256_setzero_si256();
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __m256i carry = zero;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m256i a = load(lhs[j] + i);
+            const __m256i sum = _mm256_add_epi64(a, load(rhs[j] + i));
+            const __m256i total = _mm256_sub_epi64(sum, carry);
+            carry = _mm256_or_si256(less(sum, a), _mm256_and_si256(carry, _mm256_cmpeq_epi64(total, zero)));
+            store(result[j] + i, total);
+        }
+    }
+    scalar::add<uint64_t>(result, lhs, rhs, limbs, vector_end, end);
+}
+
+ABACUS_AVX2 inline void sub(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                            std::size_t limbs, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m256i zero = _mm256_setzero_si256();
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __m256i borrow = zero;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m256i a = load(lhs[j] + i);
+            const __m256i b = load(rhs[j] + i);
+            const __m256i difference = _mm256_sub_epi64(a, b);
+            const __m256i total = _mm256_add_epi64(difference, borrow);
+            borrow = _mm256_or_si256(less(a, b), _mm256_and_si256(borrow, _mm256_cmpeq_epi64(difference, zero)));
+            store(result[j] + i, total);
+        }
+    }
+    scalar::sub<uint64_t>(result, lhs, rhs, limbs, vector_end, end);
+}
+
+ABACUS_AVX2 inline void mul_1(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                              uint64_t factor, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m256i mask = _mm256_set1_epi64x(0xffffffff);
+    const __m256i factor_low = _mm256_set1_epi64x(static_cast<int64_t>(factor & 0xffffffff));
+    const __m256i factor_high = _mm256_set1_epi64x(static_cast<int64_t>(factor >> 32));
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __m256i carry = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m256i a = load(value[j] + i);
+            const __m256i a_high = _mm256_srli_epi64(a, 32);
+            const __m256i low_low = _mm256_mul_epu32(a, factor_low);
+            const __m256i low_high = _mm256_mul_epu32(a, factor_high);
+            const __m256i high_low = _mm256_mul_epu32(a_high, factor_low);
+            const __m256i high_high = _mm256_mul_epu32(a_high, factor_high);
+
+            // The middle 32-bit column collects at most three 32-bit terms.
+            const __m256i middle =
+                _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(low_low, 32), _mm256_and_si256(low_high, mask)),
+                                 _mm256_and_si256(high_low, mask));
+            const __m256i low = _mm256_or_si256(_mm256_slli_epi64(middle, 32), _mm256_and_si256(low_low, mask));
+            __m256i high = _mm256_add_epi64(_mm256_add_epi64(high_high, _mm256_srli_epi64(middle, 32)),
+                                            _mm256_add_epi64(_mm256_srli_epi64(low_high, 32),
+                                                             _mm256_srli_epi64(high_low, 32)));
+
+            const __m256i total = _mm256_add_epi64(low, carry);
+            high = _mm256_sub_epi64(high, less(total, low));
+            store(result[j] + i, total);
+            carry = high;
+        }
+    }
+    scalar::mul_1<uint64_t>(result, value, limbs, factor, vector_end, end);
+}
+
+ABACUS_AVX2 inline void compare(int8_t* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                                std::size_t limbs, bool is_signed, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __m256i lower = _mm256_setzero_si256();
+        __m256i greater = _mm256_setzero_si256();
+        for (std::size_t j = limbs; j > 0; --j) {
+            // Flipping the top bits gives an unsigned comparison, the top plane of signed values is compared as is.
+            const __m256i flip = is_signed && j == limbs ? _mm256_setzero_si256() : sign;
+            const __m256i a = _mm256_xor_si256(load(lhs[j - 1] + i), flip);
+            const __m256i b = _mm256_xor_si256(load(rhs[j - 1] + i), flip);
+            const __m256i decided = _mm256_or_si256(lower, greater);
+            lower = _mm256_or_si256(lower, _mm256_andnot_si256(decided, _mm256_cmpgt_epi64(b, a)));
+            greater = _mm256_or_si256(greater, _mm256_andnot_si256(decided, _mm256_cmpgt_epi64(a, b)));
+            if (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(lower, greater))) == 0xf) {
+                break;
+            }
+        }
+        const int lower_bits = _mm256_movemask_pd(_mm256_castsi256_pd(lower));
+        const int greater_bits = _mm256_movemask_pd(_mm256_castsi256_pd(greater));
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            result[i + lane] = static_cast<int8_t>(((greater_bits >> lane) & 1) - ((lower_bits >> lane) & 1));
+        }
+    }
+    scalar::compare<uint64_t>(result, lhs, rhs, limbs, is_signed, vector_end, end);
+}
+
+// Shifts by 64 or more bits give zero lanes, which covers the missing neighbour of a shift by whole limbs.
+ABACUS_AVX2 inline void lshift(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                               uint32_t shift, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const std::size_t offset = shift / 64;
+    const __m128i bit = _mm_cvtsi32_si128(static_cast<int>(shift % 64));
+    const __m128i back = _mm_cvtsi32_si128(static_cast<int>(64 - shift % 64));
+    for (std::size_t j = limbs; j > 0; --j) {
+        const std::size_t k = j - 1;
+        for (std::size_t i = begin; i < vector_end; i += lanes) {
+            __m256i limb = _mm256_setzero_si256();
+            if (k >= offset) {
+                limb = _mm256_sll_epi64(load(value[k - offset] + i), bit);
+                if (k > offset) {
+                    limb = _mm256_or_si256(limb, _mm256_srl_epi64(load(value[k - offset - 1] + i), back));
+                }
+            }
+            store(result[k] + i, limb);
+        }
+    }
+    scalar::lshift<uint64_t>(result, value, limbs, shift, vector_end, end);
+}
+
+ABACUS_AVX2 inline void rshift(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                               uint32_t shift, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const std::size_t offset = shift / 64;
+    const __m128i bit = _mm_cvtsi32_si128(static_cast<int>(shift % 64));
+    const __m128i back = _mm_cvtsi32_si128(static_cast<int>(64 - shift % 64));
+    for (std::size_t k = 0; k < limbs; ++k) {
+        for (std::size_t i = begin; i < vector_end; i += lanes) {
+            __m256i limb = _mm256_setzero_si256();
+            if (k + offset < limbs) {
+                limb = _mm256_srl_epi64(load(value[k + offset] + i), bit);
+                if (k + offset + 1 < limbs) {
+                    limb = _mm256_or_si256(limb, _mm256_sll_epi64(load(value[k + offset + 1] + i), back));
+                }
+            }
+            store(result[k] + i, limb);
+        }
+    }
+    scalar::rshift<uint64_t>(result, value, limbs, shift, vector_end, end);
+}
+
+#undef ABACUS_AVX2
+
+} // namespace avx2
+
+// Eight values at a time, with the carries and comparisons in mask registers.
+namespace avx512 {
+
+// The unmasked shifts and products of GCC 12 are masked ones on an undefined value, which -Wmaybe-uninitialized
+// reports wherever they are inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+constexpr std::size_t lanes = 8;
+
+#define ABACUS_AVX512 __attribute__((target("avx512f")))
+
+ABACUS_AVX512 inline __m512i load(const uint64_t* data) { return _mm512_loadu_si512(data); }
+
+ABACUS_AVX512 inline void store(uint64_t* data, __m512i value) { _mm512_storeu_si512(data, value); }
+
+ABACUS_AVX512 inline void add(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                              std::size_t limbs, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __mmask8 carry = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m512i a = load(lhs[j] + i);
+            const __m512i sum = _mm512_add_epi64(a, load(rhs[j] + i));
+            const __m512i total = _mm512_mask_add_epi64(sum, carry, sum, one);
+            carry = static_cast<__mmask8>(_mm512_cmplt_epu64_mask(sum, a) |
+                                          _mm512_mask_cmpeq_epi64_mask(carry, total, zero));
+            store(result[j] + i, total);
+        }
+    }
+    scalar::add<uint64_t>(result, lhs, rhs, limbs, vector_end, end);
+}
+
+ABACUS_AVX512 inline void sub(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                              std::size_t limbs, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __mmask8 borrow = 0;
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m512i a = load(lhs[j] + i);
+            const __m512i b = load(rhs[j] + i);
+            const __m512i difference = _mm512_sub_epi64(a, b);
+            const __m512i total = _mm512_mask_sub_epi64(difference, borrow, difference, one);
+            borrow = static_cast<__mmask8>(_mm512_cmplt_epu64_mask(a, b) |
+                                           _mm512_mask_cmpeq_epi64_mask(borrow, difference, zero));
+            store(result[j] + i, total);
+        }
+    }
+    scalar::sub<uint64_t>(result, lhs, rhs, limbs, vector_end, end);
+}
+
+ABACUS_AVX512 inline void mul_1(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                                uint64_t factor, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const __m512i mask = _mm512_set1_epi64(0xffffffff);
+    const __m512i factor_low = _mm512_set1_epi64(static_cast<int64_t>(factor & 0xffffffff));
+    const __m512i factor_high = _mm512_set1_epi64(static_cast<int64_t>(factor >> 32));
+    const __m512i one = _mm512_set1_epi64(1);
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __m512i carry = _mm512_setzero_si512();
+        for (std::size_t j = 0; j < limbs; ++j) {
+            const __m512i a = load(value[j] + i);
+            const __m512i a_high = _mm512_srli_epi64(a, 32);
+            const __m512i low_low = _mm512_mul_epu32(a, factor_low);
+            const __m512i low_high = _mm512_mul_epu32(a, factor_high);
+            const __m512i high_low = _mm512_mul_epu32(a_high, factor_low);
+            const __m512i high_high = _mm512_mul_epu32(a_high, factor_high);
+
+            const __m512i middle =
+                _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(low_low, 32), _mm512_and_si512(low_high, mask)),
+                                 _mm512_and_si512(high_low, mask));
+            const __m512i low = _mm512_or_si512(_mm512_slli_epi64(middle, 32), _mm512_and_si512(low_low, mask));
+            const __m512i high = _mm512_add_epi64(_mm512_add_epi64(high_high, _mm512_srli_epi64(middle, 32)),
+                                                  _mm512_add_epi64(_mm512_srli_epi64(low_high, 32),
+                                                                   _mm512_srli_epi64(high_low, 32)));
+
+            const __m512i total = _mm512_add_epi64(low, carry);
+            carry = _mm512_mask_add_epi64(high, _mm512_cmplt_epu64_mask(total, low), high, one);
+            store(result[j] + i, total);
+        }
+    }
+    scalar::mul_1<uint64_t>(result, value, limbs, factor, vector_end, end);
+}
+
+ABACUS_AVX512 inline void compare(int8_t* result, const uint64_t* const* lhs, const uint64_t* const* rhs,
+                                  std::size_t limbs, bool is_signed, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    for (std::size_t i = begin; i < vector_end; i += lanes) {
+        __mmask8 lower = 0;
+        __mmask8 greater = 0;
+        for (std::size_t j = limbs; j > 0; --j) {
+            const __m512i a = load(lhs[j - 1] + i);
+            const __m512i b = load(rhs[j - 1] + i);
+            const auto open = static_cast<__mmask8>(~(lower | greater));
+            if (is_signed && j == limbs) {
+                lower |= _mm512_mask_cmplt_epi64_mask(open, a, b);
+                greater |= _mm512_mask_cmpgt_epi64_mask(open, a, b);
+            } else {
+                lower |= _mm512_mask_cmplt_epu64_mask(open, a, b);
+                greater |= _mm512_mask_cmpgt_epu64_mask(open, a, b);
+            }
+            if ((lower | greater) == 0xff) {
+                break;
+            }
+        }
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            result[i + lane] = static_cast<int8_t>(((greater >> lane) & 1) - ((lower >> lane) & 1));
+        }
+    }
+    scalar::compare<uint64_t>(result, lhs, rhs, limbs, is_signed, vector_end, end);
+}
+
+ABACUS_AVX512 inline void lshift(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                                 uint32_t shift, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const std::size_t offset = shift / 64;
+    const __m128i bit = _mm_cvtsi32_si128(static_cast<int>(shift % 64));
+    const __m128i back = _mm_cvtsi32_si128(static_cast<int>(64 - shift % 64));
+    for (std::size_t j = limbs; j > 0; --j) {
+        const std::size_t k = j - 1;
+        for (std::size_t i = begin; i < vector_end; i += lanes) {
+            __m512i limb = _mm512_setzero_si512();
+            if (k >= offset) {
+                limb = _mm512_sll_epi64(load(value[k - offset] + i), bit);
+                if (k > offset) {
+                    limb = _mm512_or_si512(limb, _mm512_srl_epi64(load(value[k - offset - 1] + i), back));
+                }
+            }
+            store(result[k] + i, limb);
+        }
+    }
+    scalar::lshift<uint64_t>(result, value, limbs, shift, vector_end, end);
+}
+
+ABACUS_AVX512 inline void rshift(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs,
+                                 uint32_t shift, std::size_t begin, std::size_t end) {
+    const std::size_t vector_end = begin + (end - begin) / lanes * lanes;
+    const std::size_t offset = shift / 64;
+    const __m128i bit = _mm_cvtsi32_si128(static_cast<int>(shift % 64));
+    const __m128i back = _mm_cvtsi32_si128(static_cast<int>(64 - shift % 64));
+    for (std::size_t k = 0; k < limbs; ++k) {
+        for (std::size_t i = begin; i < vector_end; i += lanes) {
+            __m512i limb = _mm512_setzero_si512();
+            if (k + offset < limbs) {
+                limb = _mm512_srl_epi64(load(value[k + offset] + i), bit);
+                if (k + offset + 1 < limbs) {
+                    limb = _mm512_or_si512(limb, _mm512_sll_epi64(load(value[k + offset + 1] + i), back));
+                }
+            }
+            store(result[k] + i, limb);
+        }
+    }
+    scalar::rshift<uint64_t>(result, value, limbs, shift, vector_end, end);
+}
+
+#undef ABACUS_AVX512
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace avx512
+#endif
+
+// One variant of the kernels for 64-bit limbs, see SimdKernels.
+struct KernelTable {
+    void (*add)(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs, std::size_t limbs,
+                std::size_t begin, std::size_t end);
+    void (*sub)(uint64_t* const* result, const uint64_t* const* lhs, const uint64_t* const* rhs, std::size_t limbs,
+                std::size_t begin, std::size_t end);
+    void (*mul_1)(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs, uint64_t factor,
+                  std::size_t begin, std::size_t end);
+    void (*compare)(int8_t* result, const uint64_t* const* lhs, const uint64_t* const* rhs, std::size_t limbs,
+                    bool is_signed, std::size_t begin, std::size_t end);
+    void (*lshift)(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs, uint32_t shift,
+                   std::size_t begin, std::size_t end);
+    void (*rshift)(uint64_t* const* result, const uint64_t* const* value, std::size_t limbs, uint32_t shift,
+                   std::size_t begin, std::size_t end);
+};
+
+inline constexpr KernelTable scalar_kernels = {scalar::add<uint64_t>,     scalar::sub<uint64_t>,
+                                               scalar::mul_1<uint64_t>,   scalar::compare<uint64_t>,
+                                               scalar::lshift<uint64_t>, scalar::rshift<uint64_t>};
+
+#if ABACUS_X86_KERNELS
+inline constexpr KernelTable avx2_kernels = {avx2::add,     avx2::sub,    avx2::mul_1,
+                                             avx2::compare, avx2::lshift, avx2::rshift};
+
+inline constexpr KernelTable avx512_kernels = {avx512::add,     avx512::sub,    avx512::mul_1,
+                                               avx512::compare, avx512::lshift, avx512::rshift};
+#endif
+
+// Kernels of the given variant, which the CPU has to support.
+inline const KernelTable& kernel_table(SimdKernels kernels) {
+#if ABACUS_X86_KERNELS
+    if (kernels == SimdKernels::avx512) {
+        return avx512_kernels;
+    }
+    if (kernels == SimdKernels::avx2) {
+        return avx2_kernels;
+    }
+#endif
+    static_cast<void>(kernels);
+    return scalar_kernels;
+}
+
+// Kernels chosen for the running CPU.
+inline const KernelTable& kernel_table() {
+    static const KernelTable& table = kernel_table(simd_kernels());
+    return table;
+}
+
+// The kernels over all size values, the vector ones for 64-bit limbs.
+template <typename Limb>
+void add(Limb* const* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().add(result, lhs, rhs, limbs, 0, size);
+    } else {
+        scalar::add<Limb>(result, lhs, rhs, limbs, 0, size);
+    }
+}
+
+template <typename Limb>
+void sub(Limb* const* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().sub(result, lhs, rhs, limbs, 0, size);
+    } else {
+        scalar::sub<Limb>(result, lhs, rhs, limbs, 0, size);
+    }
+}
+
+template <typename Limb>
+void mul_1(Limb* const* result, const Limb* const* value, std::size_t limbs, Limb factor, std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().mul_1(result, value, limbs, factor, 0, size);
+    } else {
+        scalar::mul_1<Limb>(result, value, limbs, factor, 0, size);
+    }
+}
+
+template <typename Limb>
+void compare(int8_t* result, const Limb* const* lhs, const Limb* const* rhs, std::size_t limbs, bool is_signed,
+             std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().compare(result, lhs, rhs, limbs, is_signed, 0, size);
+    } else {
+        scalar::compare<Limb>(result, lhs, rhs, limbs, is_signed, 0, size);
+    }
+}
+
+template <typename Limb>
+void lshift(Limb* const* result, const Limb* const* value, std::size_t limbs, uint32_t shift, std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().lshift(result, value, limbs, shift, 0, size);
+    } else {
+        scalar::lshift<Limb>(result, value, limbs, shift, 0, size);
+    }
+}
+
+template <typename Limb>
+void rshift(Limb* const* result, const Limb* const* value, std::size_t limbs, uint32_t shift, std::size_t size) {
+    if constexpr (std::is_same_v<Limb, uint64_t>) {
+        kernel_table().rshift(result, value, limbs, shift, 0, size);
+    } else {
+        scalar::rshift<Limb>(result, value, limbs, shift, 0, size);
+    }
+}
+
+} // namespace aba::detail::columns
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "integer.hpp"
+#include "limb.hpp"
+#include "thread_pool.hpp"
+
+namespace aba {
+
+namespace detail {
+
+inline Integer integer_from_word(uint64_t value) { return Integer::from_limbs(std::span<const uint64_t>(&value, 1)); }
+
+// Multiplies the factors into as few words as possible, each word collects consecutive factors while their product
+// fits. Factors must not be zero.
+inline std::vector<uint64_t> pack_words(std::span<const uint64_t> factors) {
+    std::vector<uint64_t> words;
+    uint64_t word = 1;
+    for (const uint64_t factor : factors) {
+        const auto [low, high] = mul_wide(word, factor);
+        if (high != 0) {
+            words.push_back(word);
+            word = factor;
+        } else {
+            word = low;
+        }
+    }
+    if (word != 1 || words.empty()) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+// Product of the words, splitting the range in halves so that each multiplication has operands of about the same
+// size for the subquadratic algorithms. The halves of large ranges are multiplied out on the thread pool.
+inline Integer product_tree(std::span<const uint64_t> words) {
+    if (words.empty()) {
+        return Integer(1);
+    }
+    if (words.size() == 1) {
+        return integer_from_word(words[0]);
+    }
+
+    const std::size_t middle = words.size() / 2;
+    Integer low;
+    Integer high;
+    parallel_invoke(
+        words.size(), [&] { low = product_tree(words.first(middle)); },
+        [&] { high = product_tree(words.subspan(middle)); });
+    return low *= high;
+}
+
+inline Integer product(std::span<const uint64_t> factors) { return product_tree(pack_words(factors)); }
+
+// The primes up to and including limit, by a sieve of Eratosthenes over the odd numbers.
+inline std::vector<uint64_t> primes_up_to(uint64_t limit) {
+    std::vector<uint64_t> primes;
+    if (limit < 2) {
+        return primes;
+    }
+    primes.push_back(2);
+
+    // composite[i] for the odd number 2i + 1.
+    std::vector<bool> composite((limit + 1) / 2);
+    for (uint64_t i = 1; i < composite.size(); ++i) {
+        if (composite[i]) {
+            continue;
+        }
+        const uint64_t prime = 2 * i + 1;
+        primes.push_back(prime);
+        for (uint64_t j = prime * prime / 2; j < composite.size(); j += prime) {
+            composite[j] = true;
+        }
+    }
+    return primes;
+}
+
+// Product of primes[i]^exponents[i]. Going through the bits of the exponents from the top, the value is squared and
+// multiplied with the primes whose exponent has the bit set, so the large powers come from squarings.
+inline Integer prime_power_product(std::span<const uint64_t> primes, std::span<const uint64_t> exponents) {
+    const uint64_t max_exponent = *std::max_element(exponents.begin(), exponents.end());
+
+    Integer result(1);
+    std::vector<uint64_t> factors;
+    for (auto bit = static_cast<uint32_t>(std::bit_width(max_exponent)); bit > 0; --bit) {
+        factors.clear();
+        for (std::size_t i = 0; i < primes.size(); ++i) {
+            if (((exponents[i] >> (bit - 1)) & 1) != 0) {
+                factors.push_back(primes[i]);
+            }
+        }
+        result *= result;
+        result *= product(factors);
+    }
+    return result;
+}
+
+} // namespace detail
+
+// n! = 1 * 2 * ... * n. The odd primes are raised to their exponents in n! (Legendre's formula) by
+// detail::prime_power_product() and the power of two is a final shift.
+inline Integer factorial(uint32_t n) {
+    if (n < 2) {
+        return Integer(1);
+    }
+
+    const auto primes = detail::primes_up_to(n);
+    std::vector<uint64_t> exponents(primes.size());
+    for (std::size_t i = 0; i < primes.size(); ++i) {
+        for (uint64_t quotient = n / primes[i]; quotient != 0; quotient /= primes[i]) {
+            exponents[i] += quotient;
+        }
+    }
+
+    const auto odd_primes = std::span<const uint64_t>(primes).subspan(1);
+    const auto odd_exponents = std::span<const uint64_t>(exponents).subspan(1);
+    Integer result = odd_primes.empty() ? Integer(1) : detail::prime_power_product(odd_primes, odd_exponents);
+    return result <<= static_cast<uint32_t>(exponents[0]);
+}
+
+// n! / (k! (n - k)!), zero for k > n. The factors n - k + 1, ..., n of the numerator are divided by the primes of k!
+// in single words before they are multiplied: there are at least floor(k / p^j) multiples of p^j among any k
+// consecutive numbers, and each of them gives up one factor p for every j.
+inline Integer binomial(uint64_t n, uint64_t k) {
+    if (k > n) {
+        return Integer(0);
+    }
+    k = std::min(k, n - k);
+
+    const uint64_t first = n - k + 1;
+    std::vector<uint64_t> factors(k);
+    for (uint64_t i = 0; i < k; ++i) {
+        factors[i] = first + i;
+    }
+
+    for (const uint64_t prime : detail::primes_up_to(k)) {
+        // The multiples of power = p^j in [first, n], as long as k / p^j is not zero.
+        for (uint64_t power = prime; power <= k; power *= prime) {
+            uint64_t multiple = (first + power - 1) / power * power;
+            for (uint64_t count = k / power; count > 0; --count, multiple += power) {
+                factors[multiple - first] /= prime;
+            }
+            if (power > k / prime) {
+                break;
+            }
+        }
+    }
+
+    std::erase(factors, uint64_t{1});
+    return detail::product(factors);
+}
+
+// The product of the primes up to and including n.
+inline Integer primorial(uint32_t n) { return detail::product(detail::primes_up_to(n)); }
+
+} // namespace aba
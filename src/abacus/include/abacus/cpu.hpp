@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#define ABACUS_X86_KERNELS 1
+#else
+#define ABACUS_X86_KERNELS 0
+#endif
+
+namespace aba {
+
+// Instruction set extensions of the running CPU which the limb kernels can use.
+struct CpuFeatures {
+    bool bmi2 = false;   // mulx
+    bool adx = false;    // adcx, adox
+    bool avx2 = false;   // 256-bit integer vectors
+    bool avx512 = false; // AVX-512 F, 512-bit vectors and mask registers
+};
+
+inline CpuFeatures cpu_features() {
+    CpuFeatures features;
+#if ABACUS_X86_KERNELS
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    // The vector registers are only usable if the OS saves them (OSXSAVE and the state bits of XCR0).
+    uint64_t saved_state = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & (1U << 27)) != 0) {
+        unsigned int low = 0;
+        unsigned int high = 0;
+        asm("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+        saved_state = (uint64_t{high} << 32) | low;
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0) {
+        features.bmi2 = (ebx & (1U << 8)) != 0;
+        features.adx = (ebx & (1U << 19)) != 0;
+        features.avx2 = (ebx & (1U << 5)) != 0 && (saved_state & 0x6) == 0x6;
+        features.avx512 = (ebx & (1U << 16)) != 0 && (saved_state & 0xe6) == 0xe6;
+    }
+#endif
+    return features;
+}
+
+// Variants of the 64-bit limb kernels (add, subtract, multiply by a limb, used by multiplication and division).
+enum class CpuKernels {
+    baseline,
+    bmi2_adx,
+};
+
+constexpr std::string_view to_string(CpuKernels kernels) {
+    switch (kernels) {
+    case CpuKernels::baseline:
+        return "baseline";
+    case CpuKernels::bmi2_adx:
+        return "bmi2_adx";
+    }
+    return "";
+}
+
+constexpr std::optional<CpuKernels> kernels_from_string(std::string_view name) {
+    for (const auto kernels : {CpuKernels::baseline, CpuKernels::bmi2_adx}) {
+        if (name == to_string(kernels)) {
+            return kernels;
+        }
+    }
+    return std::nullopt;
+}
+
+constexpr bool is_supported(CpuKernels kernels, const CpuFeatures& features) {
+    switch (kernels) {
+    case CpuKernels::baseline:
+        return true;
+    case CpuKernels::bmi2_adx:
+        return ABACUS_X86_KERNELS && features.bmi2 && features.adx;
+    }
+    return false;
+}
+
+// The best kernels the CPU supports. The environment variable ABACUS_CPU selects another variant by name for
+// benchmarking, one the CPU does not support falls back to baseline, an unknown name is ignored.
+inline CpuKernels select_kernels() {
+    const CpuFeatures features = cpu_features();
+    if (const char* name = std::getenv("ABACUS_CPU"); name != nullptr) {
+        if (const auto kernels = kernels_from_string(name)) {
+            return is_supported(*kernels, features) ? *kernels : CpuKernels::baseline;
+        }
+    }
+    return is_supported(CpuKernels::bmi2_adx, features) ? CpuKernels::bmi2_adx : CpuKernels::baseline;
+}
+
+// Kernels in use, chosen once on first use.
+inline CpuKernels cpu_kernels() {
+    static const CpuKernels kernels = select_kernels();
+    return kernels;
+}
+
+// Variants of the batch kernels on columns of 64-bit limbs (see BigIntColumn), which process the values in lanes of
+// vector registers.
+enum class SimdKernels {
+    scalar,
+    avx2,
+    avx512,
+};
+
+constexpr std::string_view to_string(SimdKernels kernels) {
+    switch (kernels) {
+    case SimdKernels::scalar:
+        return "scalar";
+    case SimdKernels::avx2:
+        return "avx2";
+    case SimdKernels::avx512:
+        return "avx512";
+    }
+    return "";
+}
+
+constexpr std::optional<SimdKernels> simd_kernels_from_string(std::string_view name) {
+    for (const auto kernels : {SimdKernels::scalar, SimdKernels::avx2, SimdKernels::avx512}) {
+        if (name == to_string(kernels)) {
+            return kernels;
+        }
+    }
+    return std::nullopt;
+}
+
+constexpr bool is_supported(SimdKernels kernels, const CpuFeatures& features) {
+    switch (kernels) {
+    case SimdKernels::scalar:
+        return true;
+    case SimdKernels::avx2:
+        return ABACUS_X86_KERNELS && features.avx2;
+    case SimdKernels::avx512:
+        return ABACUS_X86_KERNELS && features.avx512;
+    }
+    return false;
+}
+
+// The widest vectors the CPU supports, or the variant named by the environment variable ABACUS_SIMD as for
+// select_kernels().
+inline SimdKernels select_simd_kernels() {
+    const CpuFeatures features = cpu_features();
+    if (const char* name = std::getenv("ABACUS_SIMD"); name != nullptr) {
+        if (const auto kernels = simd_kernels_from_string(name)) {
+            return is_supported(*kernels, features) ? *kernels : SimdKernels::scalar;
+        }
+    }
+    for (const auto kernels : {SimdKernels::avx512, SimdKernels::avx2}) {
+        if (is_supported(kernels, features)) {
+            return kernels;
+        }
+    }
+    return SimdKernels::scalar;
+}
+
+inline SimdKernels simd_kernels() {
+    static const SimdKernels kernels = select_simd_kernels();
+    return kernels;
+}
+
+} // namespace aba
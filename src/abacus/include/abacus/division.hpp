@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <vector>
+
+#include "limb.hpp"
+#include "mpn.hpp"
+#include "multiplication.hpp"
+
+namespace aba {
+
+// Sizes (in limbs, of both the divisor and the quotient) from which a division recurses on the leading limbs and
+// multiplies out the rest instead of running the schoolbook division, see detail::divide().
+template <typename Limb>
+struct division_thresholds;
+
+template <>
+struct division_thresholds<uint32_t> {
+    static constexpr std::size_t recursive = 64;
+};
+
+template <>
+struct division_thresholds<uint64_t> {
+    static constexpr std::size_t recursive = 48;
+};
+
+namespace detail {
+
+template <typename Limb>
+Limb divrem_recursive(std::span<Limb> quotient, std::span<Limb> value, std::span<const Limb> divisor);
+
+// Schoolbook division of value (n + m limbs) by the normalized divisor (n limbs) for value < B^m * divisor: quotient
+// gets m limbs and the remainder is left in the low n limbs of value, the others are cleared.
+template <typename Limb>
+void divrem_basecase(std::span<Limb> quotient, std::span<Limb> value, std::span<const Limb> divisor) {
+    const std::size_t n = divisor.size();
+    const std::size_t m = quotient.size();
+
+    std::vector<Limb> scratch(2 * (n + m) + 2);
+    const auto full_quotient = std::span(scratch).first(m + 1);
+    divrem<Limb>(full_quotient, value.first(n), value, divisor, std::span(scratch).subspan(m + 1));
+    std::copy_n(full_quotient.begin(), m, quotient.begin());
+    std::fill(value.begin() + static_cast<std::ptrdiff_t>(n), value.end(), Limb{0});
+}
+
+// Division of value (n + m limbs) by the normalized divisor (n limbs) for value < B^m * divisor and m < n, from the
+// division of the leading 2m limbs of value by the leading m limbs of the divisor. That quotient is at most two too
+// large (the divisor is normalized) and is corrected with the product of the quotient and the t = n - m low limbs of
+// the divisor.
+template <typename Limb>
+void divrem_truncated(std::span<Limb> quotient, std::span<Limb> value, std::span<const Limb> divisor) {
+    const std::size_t n = divisor.size();
+    const std::size_t m = quotient.size();
+    const std::size_t t = n - m;
+    const auto divisor_low = divisor.first(t);
+
+    // value = remainder * B^t + low limbs, with remainder in value[t, n).
+    Limb quotient_high = divrem_recursive<Limb>(quotient, value.subspan(t, 2 * m), divisor.subspan(t));
+
+    std::vector<Limb> product(n);
+    multiply<Limb>(product, quotient, divisor_low);
+    Limb borrow = sub_in_place<Limb>(value.first(n), product);
+    if (quotient_high != 0) {
+        borrow += sub_in_place<Limb>(value.subspan(m, t), divisor_low);
+    }
+
+    const Limb one = 1;
+    while (borrow != 0) {
+        quotient_high -= sub_in_place<Limb>(quotient, std::span(&one, 1));
+        borrow -= add_in_place<Limb>(value.first(n), divisor);
+    }
+}
+
+// Burnikel and Ziegler's recursive division ("Fast recursive division", 1998) in the form of Brent and Zimmermann,
+// Modern Computer Arithmetic, algorithm 1.8: divides value (n + m limbs, m <= n) by the normalized divisor (n limbs),
+// quotient gets m limbs and the remainder is left in value[0, n), the rest is cleared. Returns the quotient limb m,
+// which is 1 if the leading n limbs of value are not below the divisor and 0 otherwise.
+//
+// A quotient of n limbs is produced in two halves, each from the division by the leading limbs of the divisor, so
+// that the cost is that of the multiplications, O(M(n) log n).
+template <typename Limb>
+Limb divrem_recursive(std::span<Limb> quotient, std::span<Limb> value, std::span<const Limb> divisor) {
+    const std::size_t n = divisor.size();
+    const std::size_t m = quotient.size();
+
+    Limb quotient_high = 0;
+    const auto high = value.subspan(m, n);
+    if (cmp<Limb>(high, divisor) >= 0) {
+        sub_in_place<Limb>(high, divisor);
+        quotient_high = 1;
+    }
+
+    if (m < division_thresholds<Limb>::recursive) {
+        divrem_basecase<Limb>(quotient, value, divisor);
+    } else if (m < n) {
+        divrem_truncated<Limb>(quotient, value, divisor);
+    } else {
+        const std::size_t k = m / 2;
+        divrem_truncated<Limb>(quotient.subspan(k), value.subspan(k), divisor);
+        divrem_truncated<Limb>(quotient.first(k), value.first(n + k), divisor);
+    }
+    return quotient_high;
+}
+
+// quotient = numerator / divisor and remainder = numerator mod divisor for a divisor of n >= 2 limbs with a non-zero
+// top limb and a numerator of m >= n limbs, see detail::divrem() for the sizes. Large divisions run recursively on
+// blocks of up to n quotient limbs from the top, smaller ones by the schoolbook division.
+template <typename Limb>
+void divide(std::span<Limb> quotient, std::span<Limb> remainder, std::span<const Limb> numerator,
+            std::span<const Limb> divisor) {
+    const std::size_t n = divisor.size();
+    const std::size_t m = numerator.size();
+    if (std::min(n, m - n + 1) < division_thresholds<Limb>::recursive) {
+        std::vector<Limb> scratch(m + n + 1);
+        divrem<Limb>(quotient, remainder, numerator, divisor, scratch);
+        return;
+    }
+
+    // Normalized so that the top limb of the divisor has its top bit set. The extra top limb of the value is below it,
+    // as then is the first block.
+    const auto shift = static_cast<uint32_t>(std::countl_zero(divisor[n - 1]));
+    std::vector<Limb> normalized_divisor(n);
+    lshift<Limb>(normalized_divisor, divisor, shift);
+    std::vector<Limb> value(m + 1);
+    value[m] = lshift<Limb>(std::span(value).first(m), numerator, shift);
+
+    for (std::size_t end = m - n + 1; end > 0;) {
+        const std::size_t size = std::min(end, n);
+        end -= size;
+        divrem_recursive<Limb>(quotient.subspan(end, size), std::span(value).subspan(end, n + size),
+                               normalized_divisor);
+    }
+
+    rshift<Limb>(remainder, std::span<const Limb>(value).first(n), shift);
+}
+
+} // namespace detail
+} // namespace aba
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "big_int.hpp"
+#include "limb.hpp"
+#include "mpn.hpp"
+
+namespace aba {
+
+template <typename T>
+class Divisor;
+
+// Division by a fixed divisor, normalized (shifted to set its top bit) with the reciprocal of its top limb computed
+// once, so that quotient limbs are estimated with multiplications instead of hardware divisions (in the manner of
+// libdivide). A single limb divisor divides one limb at a time with div_preinv(), longer ones run
+// detail::divrem_normalized().
+template <std::size_t Limbs, typename Limb>
+class Divisor<BigUIntN<Limbs, Limb>> {
+public:
+    using value_t = BigUIntN<Limbs, Limb>;
+
+    constexpr explicit Divisor(const value_t& divisor) : m_divisor(divisor) {
+        m_size = detail::trim<Limb>(divisor.limbs()).size();
+        if (m_size == 0) {
+            throw std::invalid_argument("Divisor must not be zero");
+        }
+
+        m_shift = static_cast<uint32_t>(std::countl_zero(divisor.limbs()[m_size - 1]));
+        detail::lshift<Limb>(m_normalized, divisor.limbs(), m_shift);
+        m_reciprocal = detail::reciprocal_word(m_normalized[m_size - 1]);
+    }
+
+    constexpr const value_t& divisor() const { return m_divisor; }
+
+    // {value / divisor, value % divisor}, as value_t::division(value, divisor()).
+    constexpr std::pair<value_t, value_t> division(const value_t& value) const {
+        return m_size == 1 ? divide_by_limb(value) : divide_by_limbs(value);
+    }
+
+    friend constexpr value_t operator/(const value_t& lhs, const Divisor& rhs) { return rhs.division(lhs).first; }
+
+    friend constexpr value_t operator%(const value_t& lhs, const Divisor& rhs) { return rhs.division(lhs).second; }
+
+private:
+    // Divides value << shift from the top, the shifted limbs are formed on the fly.
+    constexpr std::pair<value_t, value_t> divide_by_limb(const value_t& value) const {
+        constexpr uint32_t bits = detail::limb_bits<Limb>;
+        const auto limbs = detail::trim<Limb>(value.limbs());
+        std::array<Limb, Limbs> quotient{};
+        Limb remainder = 0;
+        if (!limbs.empty() && m_shift != 0) {
+            remainder = limbs.back() >> (bits - m_shift);
+        }
+        for (std::size_t i = limbs.size(); i > 0; --i) {
+            auto limb = static_cast<Limb>(limbs[i - 1] << m_shift);
+            if (i >= 2 && m_shift != 0) {
+                limb |= static_cast<Limb>(limbs[i - 2] >> (bits - m_shift));
+            }
+            std::tie(quotient[i - 1], remainder) = detail::div_preinv(remainder, limb, m_normalized[0], m_reciprocal);
+        }
+        return {value_t(quotient), value_t(remainder >> m_shift)};
+    }
+
+    constexpr std::pair<value_t, value_t> divide_by_limbs(const value_t& value) const {
+        const std::size_t n = m_size;
+        const std::size_t m = detail::trim<Limb>(value.limbs()).size();
+        if (m < n) {
+            return {value_t(0), value};
+        }
+
+        std::array<Limb, Limbs + 1> un{};
+        un[m] = detail::lshift<Limb>(std::span(un).first(m), value.limbs().first(m), m_shift);
+        std::array<Limb, Limbs> quotient{};
+        detail::divrem_normalized<Limb>(std::span(quotient).first(m - n + 1), std::span(un).first(m + 1),
+                                        std::span<const Limb>(m_normalized).first(n), m_reciprocal);
+
+        std::array<Limb, Limbs> remainder{};
+        detail::rshift<Limb>(std::span(remainder).first(n), std::span<const Limb>(un).first(n), m_shift);
+        return {value_t(quotient), value_t(remainder)};
+    }
+
+    value_t m_divisor;
+    std::size_t m_size = 0;
+    uint32_t m_shift = 0;
+    // divisor << shift, and the reciprocal of its top limb.
+    std::array<Limb, Limbs> m_normalized{};
+    Limb m_reciprocal = 0;
+};
+
+// Truncating division by a fixed signed divisor, the remainder has the sign of the value (as BigIntN::division).
+template <std::size_t Limbs, typename Limb>
+class Divisor<BigIntN<Limbs, Limb>> {
+public:
+    using value_t = BigIntN<Limbs, Limb>;
+    using unsigned_t = BigUIntN<Limbs, Limb>;
+
+    constexpr explicit Divisor(const value_t& divisor)
+        : m_divisor(divisor), m_magnitude(divisor.is_negative() ? unsigned_t(-divisor) : unsigned_t(divisor)) {}
+
+    constexpr const value_t& divisor() const { return m_divisor; }
+
+    constexpr std::pair<value_t, value_t> division(const value_t& value) const {
+        const bool negative = value.is_negative();
+        const auto [quotient, remainder] = m_magnitude.division(negative ? unsigned_t(-value) : unsigned_t(value));
+        return {negative != m_divisor.is_negative() ? -value_t(quotient) : value_t(quotient),
+                negative ? -value_t(remainder) : value_t(remainder)};
+    }
+
+    friend constexpr value_t operator/(const value_t& lhs, const Divisor& rhs) { return rhs.division(lhs).first; }
+
+    friend constexpr value_t operator%(const value_t& lhs, const Divisor& rhs) { return rhs.division(lhs).second; }
+
+private:
+    value_t m_divisor;
+    Divisor<unsigned_t> m_magnitude;
+};
+
+} // namespace aba
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "big_int.hpp"
+#include "big_int_functions.hpp"
+
+namespace aba {
+
+// Compact binary encoding of BigUIntN and BigIntN values. A value is a header of 2 * bytes + sign as an unsigned
+// LEB128 varint, followed by the magnitude as that many little endian bytes, the top one not zero. Zero is the single
+// byte 0 and every value has exactly one encoding, which is the same for all widths: a value encoded from one type
+// decodes to any type it fits in. Neither encoding nor decoding allocates.
+
+namespace detail {
+
+constexpr std::size_t varint_size(uint64_t value) {
+    std::size_t size = 1;
+    for (; value >= 0x80; value >>= 7) {
+        ++size;
+    }
+    return size;
+}
+
+// Headers longer than this give more bytes than any value has.
+inline constexpr std::size_t max_header_size = 9;
+
+// Encodes value at the start of out and returns its size, or nothing if out is too small.
+template <typename T>
+constexpr std::optional<std::size_t> encode_prefix(const T& value, std::span<std::byte> out) {
+    using limb_t = typename T::data_t;
+    const auto magnitude = detail::magnitude(value);
+    const std::size_t bytes = (magnitude.bit_length() + 7) / 8;
+    uint64_t header = bytes * 2 + (value < T(0) ? 1 : 0);
+    const std::size_t header_size = varint_size(header);
+    if (out.size() < header_size + bytes) {
+        return std::nullopt;
+    }
+    for (std::size_t i = 0; i + 1 < header_size; ++i) {
+        out[i] = static_cast<std::byte>((header & 0x7f) | 0x80);
+        header >>= 7;
+    }
+    out[header_size - 1] = static_cast<std::byte>(header);
+
+    const auto payload = out.subspan(header_size, bytes);
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+        std::memcpy(payload.data(), magnitude.limbs().data(), bytes);
+    } else {
+        for (std::size_t k = 0; k < bytes; ++k) {
+            const limb_t limb = magnitude.limbs()[k / sizeof(limb_t)];
+            payload[k] = static_cast<std::byte>(limb >> (8 * (k % sizeof(limb_t))));
+        }
+    }
+    return header_size + bytes;
+}
+
+// Decodes the value at the start of in and returns it with its size, or nothing if in ends before it.
+template <typename T>
+constexpr std::optional<std::pair<T, std::size_t>> decode_prefix(std::span<const std::byte> in) {
+    using limb_t = typename T::data_t;
+    using unsigned_t = magnitude_t<T>;
+    uint64_t header = 0;
+    std::size_t header_size = 0;
+    while (true) {
+        if (header_size == in.size()) {
+            return std::nullopt;
+        }
+        if (header_size == max_header_size) {
+            throw std::out_of_range("Encoded value does not fit");
+        }
+        const auto byte = static_cast<uint8_t>(in[header_size]);
+        header |= static_cast<uint64_t>(byte & 0x7f) << (7 * header_size);
+        ++header_size;
+        if ((byte & 0x80) == 0) {
+            if (byte == 0 && header_size > 1) {
+                throw std::invalid_argument("Invalid encoding");
+            }
+            break;
+        }
+    }
+
+    const uint64_t bytes = header / 2;
+    const bool negative = (header & 1) != 0;
+    if (bytes > T::n_bits / 8 || (negative && std::is_same_v<T, unsigned_t>)) {
+        throw std::out_of_range("Encoded value does not fit");
+    }
+    if (in.size() - header_size < bytes) {
+        return std::nullopt;
+    }
+    const auto payload = in.subspan(header_size, static_cast<std::size_t>(bytes));
+    // A zero byte on top, or a negative zero.
+    if (bytes == 0 ? negative : payload.back() == std::byte{0}) {
+        throw std::invalid_argument("Invalid encoding");
+    }
+
+    std::array<limb_t, T::data_size> data{};
+    if (!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+        std::memcpy(data.data(), payload.data(), payload.size());
+    } else {
+        for (std::size_t k = 0; k < payload.size(); ++k) {
+            const auto byte = static_cast<limb_t>(payload[k]);
+            data[k / sizeof(limb_t)] |= static_cast<limb_t>(byte << (8 * (k % sizeof(limb_t))));
+        }
+    }
+    const std::size_t size = header_size + payload.size();
+    if constexpr (std::is_same_v<T, unsigned_t>) {
+        return std::pair{T(data), size};
+    } else {
+        const T value = negative ? -T(data) : T(data);
+        // Magnitudes above the maximum, or above the magnitude of the minimum when negative, wrap the sign.
+        if (value.is_negative() != negative) {
+            throw std::out_of_range("Encoded value does not fit");
+        }
+        return std::pair{value, size};
+    }
+}
+
+} // namespace detail
+
+// Bytes of the longest encoding of a T.
+template <typename T>
+inline constexpr std::size_t max_encoded_size = detail::varint_size(T::n_bits / 8 * 2 + 1) + T::n_bits / 8;
+
+template <typename T>
+constexpr std::size_t encoded_size(const T& value) {
+    const std::size_t bytes = (detail::magnitude(value).bit_length() + 7) / 8;
+    return detail::varint_size(bytes * 2 + (value < T(0) ? 1 : 0)) + bytes;
+}
+
+// Writes the encoding of value to the start of out and returns the bytes written.
+template <typename T>
+constexpr std::size_t encode(const T& value, std::span<std::byte> out) {
+    const auto size = detail::encode_prefix(value, out);
+    if (!size) {
+        throw std::invalid_argument("Buffer is too small");
+    }
+    return *size;
+}
+
+// Reads the value encoded at the start of in and returns it with the bytes read. Throws std::out_of_range if the
+// value does not fit in T.
+template <typename T>
+constexpr std::pair<T, std::size_t> decode(std::span<const std::byte> in) {
+    const auto result = detail::decode_prefix<T>(in);
+    if (!result) {
+        throw std::invalid_argument("Encoding is truncated");
+    }
+    return *result;
+}
+
+// Values and bytes processed by the batch functions.
+struct CodingResult {
+    std::size_t values = 0;
+    std::size_t bytes = 0;
+};
+
+// Encodes values one after the other into out, as many as fit. A stream of values goes through a fixed buffer by
+// sending the bytes written and continuing with the values left.
+template <typename T>
+constexpr CodingResult encode_values(std::span<const T> values, std::span<std::byte> out) {
+    CodingResult result;
+    for (; result.values < values.size(); ++result.values) {
+        const auto size = detail::encode_prefix(values[result.values], out.subspan(result.bytes));
+        if (!size) {
+            break;
+        }
+        result.bytes += *size;
+    }
+    return result;
+}
+
+// Decodes the values one after the other in, as many as out holds. A value cut off at the end of in is left for the
+// next call, so a stream of bytes is decoded by keeping the bytes not read in front of those received next.
+template <typename T>
+constexpr CodingResult decode_values(std::span<const std::byte> in, std::span<T> out) {
+    CodingResult result;
+    for (; result.values < out.size(); ++result.values) {
+        const auto value = detail::decode_prefix<T>(in.subspan(result.bytes));
+        if (!value) {
+            break;
+        }
+        out[result.values] = value->first;
+        result.bytes += value->second;
+    }
+    return result;
+}
+
+} // namespace aba
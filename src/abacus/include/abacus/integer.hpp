@@ -0,0 +1,702 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "big_int.hpp"
+#include "division.hpp"
+#include "limb.hpp"
+#include "limb_vector.hpp"
+#include "mpn.hpp"
+#include "multiplication.hpp"
+#include "ntt.hpp"
+#include "radix.hpp"
+#include "thread_pool.hpp"
+
+namespace aba {
+
+// Arbitrary precision signed integer. The magnitude grows as needed, values of up to inline_limbs limbs are stored
+// inside the object so that they never touch the allocator.
+class Integer {
+public:
+    using data_t = uint64_t;
+    static constexpr std::size_t n_data_bits = std::numeric_limits<data_t>::digits;
+    static constexpr std::size_t inline_limbs = 2;
+
+    Integer() = default;
+
+    Integer(int64_t value) : m_negative(value < 0) {
+        // Negate in unsigned arithmetic so that the minimum value does not overflow.
+        const auto magnitude = value < 0 ? uint64_t{0} - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        if (magnitude != 0) {
+            m_limbs.push_back(magnitude);
+        }
+    }
+
+    friend std::strong_ordering operator<=>(const Integer& lhs, const Integer& rhs) {
+        if (lhs.m_negative != rhs.m_negative) {
+            return lhs.m_negative ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        const auto order = compare_magnitude(lhs.m_limbs, rhs.m_limbs);
+        return lhs.m_negative ? 0 <=> order : order;
+    }
+
+    friend bool operator==(const Integer& lhs, const Integer& rhs) {
+        return lhs.m_negative == rhs.m_negative && compare_magnitude(lhs.m_limbs, rhs.m_limbs) == 0;
+    }
+
+    friend bool operator!=(const Integer& lhs, const Integer& rhs) { return !(lhs == rhs); }
+
+    friend Integer operator+(const Integer& lhs, const Integer& rhs) { return add(lhs, rhs, rhs.m_negative); }
+
+    friend Integer operator-(const Integer& lhs, const Integer& rhs) { return add(lhs, rhs, !rhs.m_negative); }
+
+    friend Integer operator*(const Integer& lhs, const Integer& rhs) {
+        Integer result;
+        result.m_limbs = multiply_magnitude(lhs.m_limbs, rhs.m_limbs);
+        result.m_negative = lhs.m_negative != rhs.m_negative && !result.m_limbs.empty();
+        return result;
+    }
+
+    friend Integer operator/(const Integer& lhs, const Integer& rhs) { return Integer::division(lhs, rhs).first; }
+
+    friend Integer operator-(const Integer& value) {
+        Integer result = value;
+        result.m_negative = !value.m_negative && !value.m_limbs.empty();
+        return result;
+    }
+
+    friend Integer operator%(const Integer& lhs, const Integer& rhs) { return Integer::division(lhs, rhs).second; }
+
+    // Shifts act on the magnitude, i.e. a right shift of a negative value rounds towards zero.
+    friend Integer operator>>(const Integer& lhs, uint32_t rhs) {
+        const std::size_t limbs = rhs / n_data_bits;
+        if (limbs >= lhs.m_limbs.size()) {
+            return Integer(0);
+        }
+
+        Integer result;
+        result.m_limbs.resize(lhs.m_limbs.size() - limbs);
+        detail::rshift<data_t>(result.m_limbs.span(), lhs.m_limbs.span().subspan(limbs), rhs % n_data_bits);
+        result.m_limbs.normalize();
+        result.m_negative = lhs.m_negative && !result.m_limbs.empty();
+        return result;
+    }
+
+    friend Integer operator<<(const Integer& lhs, uint32_t rhs) {
+        if (lhs.m_limbs.empty()) {
+            return lhs;
+        }
+
+        const std::size_t limbs = rhs / n_data_bits;
+        const std::size_t size = lhs.m_limbs.size();
+
+        Integer result;
+        result.m_limbs.resize(size + limbs + 1);
+        result.m_limbs[size + limbs] =
+            detail::lshift<data_t>(result.m_limbs.span().subspan(limbs, size), lhs.m_limbs.span(), rhs % n_data_bits);
+        result.m_limbs.normalize();
+        result.m_negative = lhs.m_negative;
+        return result;
+    }
+
+    // Adding to or subtracting from a magnitude at least as long as the other one happens in place, without
+    // allocating unless a carry grows the value.
+    Integer& operator+=(const Integer& rhs) { return add_assign(rhs, rhs.m_negative); }
+
+    Integer& operator-=(const Integer& rhs) { return add_assign(rhs, !rhs.m_negative); }
+
+    Integer& operator*=(const Integer& rhs) { return *this = *this * rhs; }
+
+    Integer& operator<<=(uint32_t rhs) { return *this = *this << rhs; }
+
+    Integer& operator>>=(uint32_t rhs) { return *this = *this >> rhs; }
+
+    // Truncating division, the remainder has the sign of lhs (as for BigInt and the built in integers). Throws
+    // std::invalid_argument for a zero divisor.
+    static std::pair<Integer, Integer> division(const Integer& lhs, const Integer& rhs) {
+        std::pair<Integer, Integer> result;
+        auto& [quotient, remainder] = result;
+        std::tie(quotient.m_limbs, remainder.m_limbs) = divide_magnitude(lhs.m_limbs, rhs.m_limbs);
+        quotient.m_negative = lhs.m_negative != rhs.m_negative && !quotient.m_limbs.empty();
+        remainder.m_negative = lhs.m_negative && !remainder.m_limbs.empty();
+        return result;
+    }
+
+    static Integer pow(const Integer& lhs, uint32_t exponent) {
+        Integer result(1);
+        Integer square = lhs;
+        while (exponent != 0) {
+            if ((exponent & 1) != 0) {
+                result = result * square;
+            }
+            exponent = exponent >> 1;
+            if (exponent != 0) {
+                square = square * square;
+            }
+        }
+        return result;
+    }
+
+    // Number of digits in the given base (2 to 36), estimated from the bit length with at most one comparison to a
+    // power of the base, see detail::digit_bounds(). Long values build the power from the cached radix powers.
+    uint32_t digits(uint32_t base) const {
+        const std::size_t bits = bit_length();
+        if (bits == 0) {
+            return 1;
+        }
+        auto [digits, max_digits] = detail::digit_bounds(bits, base);
+        if (digits == max_digits) {
+            return digits;
+        }
+
+        Integer power = m_limbs.size() >= to_string_threshold ? radix_pow(base, digits) : pow(Integer(base), digits);
+        while (digits < max_digits && compare_magnitude(m_limbs, power.m_limbs) >= 0) {
+            digits += 1;
+            power = power * Integer(base);
+        }
+        return digits;
+    }
+
+    // Writes the digits of the value in the given base (2 to 36) to [first, last), negative values are prefixed with
+    // '-'. On success returns a pointer one past the last written character, or {last, std::errc::value_too_large} if
+    // the range is too small.
+    std::to_chars_result to_chars(char* first, char* last, uint32_t base = 10) const {
+        if (m_negative) {
+            if (first == last) {
+                return {last, std::errc::value_too_large};
+            }
+            *first++ = '-';
+        }
+
+        if (m_limbs.size() >= to_string_threshold) {
+            std::string text;
+            append_magnitude_digits(text, base);
+            if (text.size() > static_cast<std::size_t>(last - first)) {
+                return {last, std::errc::value_too_large};
+            }
+            return {std::copy(text.begin(), text.end(), first), std::errc{}};
+        }
+
+        // The digits are produced least significant first, so write them from the back of the range and move them to
+        // the front once done.
+        const auto [chunk, chunk_digits] = detail::digit_chunk<data_t>(base);
+
+        limbs_t value = m_limbs;
+        char* begin = last;
+        do {
+            data_t rem = divide_by_limb(value, chunk);
+            const bool last_chunk = value.empty();
+            for (uint32_t i = 0; i < chunk_digits && (!last_chunk || rem != 0 || i == 0); ++i) {
+                if (begin == first) {
+                    return {last, std::errc::value_too_large};
+                }
+                *--begin = BigUInt::representation[static_cast<std::size_t>(rem % base)];
+                rem /= base;
+            }
+        } while (!value.empty());
+
+        return {std::copy(begin, last, first), std::errc{}};
+    }
+
+    std::string to_string(uint16_t base) const {
+        if (m_limbs.size() >= to_string_threshold) {
+            std::string result(m_negative ? "-" : "");
+            append_magnitude_digits(result, base);
+            return result;
+        }
+
+        // Size the string from the bit length, with room for the sign and rounding of the logarithm.
+        const auto bits = static_cast<double>(bit_length());
+        std::string result(static_cast<std::size_t>(bits / std::log2(static_cast<double>(base))) + 3, '\0');
+        const auto [end, ec] = to_chars(result.data(), result.data() + result.size(), base);
+        result.resize(static_cast<std::size_t>(end - result.data()));
+        return result;
+    }
+
+    std::string to_string() const { return to_string(10); }
+
+    // Parses the digits at the start of [first, last) in the given base (2 to 36), with an optional leading '-', see
+    // BigUIntN::from_chars. The digits are validated first and then converted by parse_digits().
+    static std::from_chars_result from_chars(const char* first, const char* last, Integer& value, uint32_t base = 10) {
+        if (base < 2 || base > 36) {
+            return {first, std::errc::invalid_argument};
+        }
+
+        const bool negative = first != last && *first == '-';
+        const char* digits = negative ? first + 1 : first;
+        const char* end = detail::scan_digits(digits, last, base);
+        if (end == digits) {
+            return {first, std::errc::invalid_argument};
+        }
+
+        value = parse_digits(std::string_view(digits, static_cast<std::size_t>(end - digits)), base);
+        value.m_negative = negative && !value.m_limbs.empty();
+        return {end, std::errc{}};
+    }
+
+    // Parses the whole string, throws std::invalid_argument if it is not a number in the base.
+    static Integer from_string(std::string_view str, uint32_t base = 10) {
+        Integer result;
+        const auto [ptr, ec] = from_chars(str.data(), str.data() + str.size(), result, base);
+        if (ec != std::errc{} || ptr != str.data() + str.size()) {
+            throw std::invalid_argument("Invalid number");
+        }
+        return result;
+    }
+
+    long double to_double() const {
+        long double result = 0;
+        for (std::size_t i = m_limbs.size(); i > 0; --i) {
+            result = result * aba::pow<long double>(2.0, n_data_bits) + static_cast<long double>(m_limbs[i - 1]);
+        }
+
+        return m_negative ? -result : result;
+    }
+
+    bool is_negative() const { return m_negative; }
+
+    // Number of bits needed to represent the magnitude, zero for zero.
+    std::size_t bit_length() const {
+        if (m_limbs.empty()) {
+            return 0;
+        }
+        return m_limbs.size() * n_data_bits - static_cast<std::size_t>(std::countl_zero(m_limbs.back()));
+    }
+
+    // Number of limbs in the magnitude.
+    std::size_t size() const { return m_limbs.size(); }
+
+    // True if the magnitude is stored inside the object.
+    bool is_inline() const { return m_limbs.is_inline(); }
+
+    // Limbs of the magnitude, least significant first.
+    std::span<const data_t> limbs() const { return m_limbs.span(); }
+
+    // The value with the given magnitude (least significant limb first) and sign, the inverse of limbs().
+    static Integer from_limbs(std::span<const data_t> limbs, bool negative = false) {
+        Integer result;
+        result.m_limbs.resize(limbs.size());
+        std::copy(limbs.begin(), limbs.end(), result.m_limbs.begin());
+        result.m_limbs.normalize();
+        result.m_negative = negative && !result.m_limbs.empty();
+        return result;
+    }
+
+private:
+    friend class Multiplier;
+
+    using limbs_t = detail::LimbVector<data_t, inline_limbs>;
+
+    // Sizes (in limbs) from which the radix conversions split the value in halves around a power of the base instead
+    // of converting one limb sized chunk of digits at a time, and from which a reciprocal is computed with Newton's
+    // iteration instead of a long division.
+    static constexpr std::size_t to_string_threshold = 40;
+    static constexpr std::size_t from_string_threshold = 40;
+    static constexpr std::size_t reciprocal_threshold = 32;
+
+    // chunk^(2^k) for the largest power chunk of the base that fits a limb, with its number of digits and lazily
+    // its reciprocal.
+    struct RadixPower;
+
+    // The power tables are built on demand and kept for later conversions, entries never change once added.
+    static const RadixPower& radix_power(uint32_t base, std::size_t k, bool with_reciprocal = false);
+
+    // Smallest k for which a value of the given size is below radix_power(base, k)^2.
+    static std::size_t radix_level(uint32_t base, std::size_t size);
+
+    // base^exponent as a product of the cached radix powers.
+    static Integer radix_pow(uint32_t base, uint32_t exponent);
+
+    // floor(B^2n / divisor) for a positive divisor of n limbs, B = 2^64.
+    static Integer reciprocal(const Integer& divisor);
+
+    // {value / power, value % power} for 0 <= value < power^2.
+    static std::pair<Integer, Integer> divide_by_power(const Integer& value, const RadixPower& power);
+
+    // Appends the digits of 0 <= value < radix_power(base, k)^2, zero padded to width digits if width is not zero.
+    static void append_digits(std::string& out, const Integer& value, uint32_t base, std::size_t k, std::size_t width);
+
+    // Appends the digits of the magnitude of a value of at least to_string_threshold limbs, see append_digits().
+    void append_magnitude_digits(std::string& out, uint32_t base) const;
+
+    // Value of the (already validated) digits, the high and low halves of long inputs are converted separately and
+    // combined with a power of the base.
+    static Integer parse_digits(std::string_view digits, uint32_t base);
+
+    static Integer add(const Integer& lhs, const Integer& rhs, bool rhs_negative) {
+        Integer result;
+        if (lhs.m_negative == rhs_negative) {
+            result.m_limbs = add_magnitude(lhs.m_limbs, rhs.m_limbs);
+            result.m_negative = lhs.m_negative;
+        } else if (compare_magnitude(lhs.m_limbs, rhs.m_limbs) >= 0) {
+            result.m_limbs = subtract_magnitude(lhs.m_limbs, rhs.m_limbs);
+            result.m_negative = lhs.m_negative;
+        } else {
+            result.m_limbs = subtract_magnitude(rhs.m_limbs, lhs.m_limbs);
+            result.m_negative = rhs_negative;
+        }
+        result.m_negative = result.m_negative && !result.m_limbs.empty();
+        return result;
+    }
+
+    Integer& add_assign(const Integer& rhs, bool rhs_negative) {
+        if (m_limbs.size() < rhs.m_limbs.size()) {
+            return *this = add(*this, rhs, rhs_negative);
+        }
+
+        if (m_negative == rhs_negative) {
+            const data_t carry = detail::add_in_place<data_t>(m_limbs.span(), rhs.m_limbs.span());
+            if (carry != 0) {
+                m_limbs.push_back(carry);
+            }
+            m_negative = rhs_negative && !m_limbs.empty();
+            return *this;
+        }
+
+        if (compare_magnitude(m_limbs, rhs.m_limbs) < 0) {
+            return *this = add(*this, rhs, rhs_negative);
+        }
+        detail::sub_in_place<data_t>(m_limbs.span(), rhs.m_limbs.span());
+        m_limbs.normalize();
+        m_negative = m_negative && !m_limbs.empty();
+        return *this;
+    }
+
+    static std::strong_ordering compare_magnitude(const limbs_t& lhs, const limbs_t& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return lhs.size() <=> rhs.size();
+        }
+        return detail::cmp<data_t>(lhs.span(), rhs.span());
+    }
+
+    static limbs_t add_magnitude(const limbs_t& lhs, const limbs_t& rhs) {
+        const limbs_t& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+        const limbs_t& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+
+        limbs_t result = longer;
+        const data_t carry = detail::add_in_place<data_t>(result.span(), shorter.span());
+        if (carry != 0) {
+            result.push_back(carry);
+        }
+        return result;
+    }
+
+    // Requires lhs >= rhs.
+    static limbs_t subtract_magnitude(const limbs_t& lhs, const limbs_t& rhs) {
+        limbs_t result = lhs;
+        detail::sub_in_place<data_t>(result.span(), rhs.span());
+        result.normalize();
+        return result;
+    }
+
+    static limbs_t multiply_magnitude(const limbs_t& lhs, const limbs_t& rhs) {
+        if (lhs.empty() || rhs.empty()) {
+            return limbs_t();
+        }
+
+        limbs_t result(lhs.size() + rhs.size());
+        if (&lhs == &rhs || (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()))) {
+            detail::square<data_t>(result.span(), lhs.span());
+        } else {
+            detail::multiply<data_t>(result.span(), lhs.span(), rhs.span());
+        }
+        result.normalize();
+        return result;
+    }
+
+    // value = value * factor + addend.
+    static void multiply_add_limb(limbs_t& value, data_t factor, data_t addend) {
+        if (value.empty()) {
+            if (addend != 0) {
+                value.push_back(addend);
+            }
+            return;
+        }
+
+        data_t carry = detail::mul_1<data_t>(value.span(), value.span(), factor);
+        carry += detail::add_in_place<data_t>(value.span(), std::span<const data_t>(&addend, 1));
+        if (carry != 0) {
+            value.push_back(carry);
+        }
+    }
+
+    // Divides value in place by a single limb and returns the remainder.
+    static data_t divide_by_limb(limbs_t& value, data_t divisor) {
+        const data_t rem = detail::divrem_1<data_t>(value.span(), value.span(), divisor);
+        value.normalize();
+        return rem;
+    }
+
+    static std::pair<limbs_t, limbs_t> divide_magnitude(const limbs_t& lhs, const limbs_t& rhs) {
+        const std::size_t n = rhs.size();
+        const std::size_t m = lhs.size();
+        if (n == 0) {
+            throw std::invalid_argument("Division by zero");
+        }
+
+        if (compare_magnitude(lhs, rhs) < 0) {
+            return {limbs_t(), lhs};
+        }
+
+        if (n <= 1) {
+            limbs_t quotient = lhs;
+            limbs_t remainder;
+            remainder.push_back(divide_by_limb(quotient, rhs[0]));
+            remainder.normalize();
+            return {std::move(quotient), std::move(remainder)};
+        }
+
+        limbs_t quotient(m - n + 1);
+        limbs_t remainder(n);
+        detail::divide<data_t>(quotient.span(), remainder.span(), lhs.span(), rhs.span());
+        quotient.normalize();
+        remainder.normalize();
+        return {std::move(quotient), std::move(remainder)};
+    }
+
+    limbs_t m_limbs;
+    bool m_negative = false;
+};
+
+struct Integer::RadixPower {
+    Integer power;
+    std::size_t digits = 0;
+    std::unique_ptr<Integer> reciprocal;
+};
+
+// The lock is only held to look up and publish entries, never across the products and reciprocals: those run on the
+// thread pool, whose workers may be in a conversion task waiting for the same table. Threads racing for an entry
+// compute it each and the first one published is kept, published entries never change.
+inline const Integer::RadixPower& Integer::radix_power(uint32_t base, std::size_t k, bool with_reciprocal) {
+    static std::mutex mutex;
+    static std::array<std::vector<std::unique_ptr<RadixPower>>, 37> tables;
+
+    auto& table = tables[base];
+    RadixPower* entry = nullptr;
+    while (entry == nullptr) {
+        const RadixPower* last = nullptr;
+        std::size_t size = 0;
+        {
+            std::scoped_lock lock(mutex);
+            size = table.size();
+            if (size > k) {
+                entry = table[k].get();
+                break;
+            }
+            last = size == 0 ? nullptr : table.back().get();
+        }
+
+        auto next = std::make_unique<RadixPower>();
+        if (last == nullptr) {
+            const auto [chunk, chunk_digits] = detail::digit_chunk<data_t>(base);
+            next->power.m_limbs.push_back(chunk);
+            next->digits = chunk_digits;
+        } else {
+            next->power = last->power * last->power;
+            next->digits = 2 * last->digits;
+        }
+
+        std::scoped_lock lock(mutex);
+        if (table.size() == size) {
+            table.push_back(std::move(next));
+        }
+    }
+
+    if (with_reciprocal) {
+        {
+            std::scoped_lock lock(mutex);
+            if (entry->reciprocal) {
+                return *entry;
+            }
+        }
+        auto inverse = std::make_unique<Integer>(reciprocal(entry->power));
+        std::scoped_lock lock(mutex);
+        if (!entry->reciprocal) {
+            entry->reciprocal = std::move(inverse);
+        }
+    }
+    return *entry;
+}
+
+inline std::size_t Integer::radix_level(uint32_t base, std::size_t size) {
+    std::size_t k = 0;
+    while (2 * radix_power(base, k).power.size() - 1 <= size) {
+        k += 1;
+    }
+    return k;
+}
+
+inline Integer Integer::radix_pow(uint32_t base, uint32_t exponent) {
+    const auto chunk_digits = detail::digit_chunk<data_t>(base).second;
+    Integer result = pow(Integer(base), exponent % chunk_digits);
+    uint32_t chunks = exponent / chunk_digits;
+    for (std::size_t k = 0; chunks != 0; ++k, chunks >>= 1) {
+        if ((chunks & 1) != 0) {
+            result = result * radix_power(base, k).power;
+        }
+    }
+    return result;
+}
+
+// Newton's iteration x + x * (B^2n - d * x) / B^2n from the reciprocal of the top n / 2 + 2 limbs leaves an error of
+// a few units, which is then corrected.
+inline Integer Integer::reciprocal(const Integer& divisor) {
+    const std::size_t n = divisor.size();
+    const auto bits = static_cast<uint32_t>(2 * n * n_data_bits);
+    const Integer one = Integer(1) << bits;
+    if (n <= reciprocal_threshold) {
+        return one / divisor;
+    }
+
+    const auto low_bits = static_cast<uint32_t>((n - (n / 2 + 2)) * n_data_bits);
+    Integer x = reciprocal(divisor >> low_bits) << low_bits;
+    x = x + ((x * (one - divisor * x)) >> bits);
+
+    Integer rem = one - divisor * x;
+    while (rem.m_negative) {
+        x = x - 1;
+        rem = rem + divisor;
+    }
+    while (rem >= divisor) {
+        x = x + 1;
+        rem = rem - divisor;
+    }
+    return x;
+}
+
+// The product with the reciprocal is at most two short of the quotient.
+inline std::pair<Integer, Integer> Integer::divide_by_power(const Integer& value, const RadixPower& power) {
+    const auto bits = static_cast<uint32_t>(2 * power.power.size() * n_data_bits);
+    Integer quotient = (value * *power.reciprocal) >> bits;
+    Integer remainder = value - quotient * power.power;
+    while (remainder >= power.power) {
+        quotient = quotient + 1;
+        remainder = remainder - power.power;
+    }
+    return {std::move(quotient), std::move(remainder)};
+}
+
+inline void Integer::append_digits(std::string& out, const Integer& value, uint32_t base, std::size_t k,
+                                   std::size_t width) {
+    if (k == 0 || value.size() < to_string_threshold) {
+        const auto [chunk, chunk_digits] = detail::digit_chunk<data_t>(base);
+
+        std::string digits;
+        limbs_t rest = value.m_limbs;
+        while (!rest.empty()) {
+            data_t rem = divide_by_limb(rest, chunk);
+            for (uint32_t i = 0; i < chunk_digits && (!rest.empty() || rem != 0); ++i) {
+                digits.push_back(BigUInt::representation[static_cast<std::size_t>(rem % base)]);
+                rem /= base;
+            }
+        }
+        if (digits.size() < std::max<std::size_t>(width, 1)) {
+            digits.resize(std::max<std::size_t>(width, 1), '0');
+        }
+        out.append(digits.rbegin(), digits.rend());
+        return;
+    }
+
+    // Without padding there are no leading zeros to write for a value below the power.
+    const auto& power = radix_power(base, k, true);
+    if (width == 0 && compare_magnitude(value.m_limbs, power.power.m_limbs) < 0) {
+        append_digits(out, value, base, k - 1, 0);
+        return;
+    }
+
+    const auto [quotient, remainder] = divide_by_power(value, power);
+    if (!detail::is_parallel(value.size())) {
+        append_digits(out, quotient, base, k - 1, width == 0 ? 0 : width - power.digits);
+        append_digits(out, remainder, base, k - 1, power.digits);
+        return;
+    }
+
+    // The low digits go to a string of their own while the high ones are appended.
+    std::string low;
+    detail::parallel_invoke(
+        value.size(), [&] { append_digits(out, quotient, base, k - 1, width == 0 ? 0 : width - power.digits); },
+        [&] { append_digits(low, remainder, base, k - 1, power.digits); });
+    out += low;
+}
+
+inline void Integer::append_magnitude_digits(std::string& out, uint32_t base) const {
+    Integer magnitude = *this;
+    magnitude.m_negative = false;
+    append_digits(out, magnitude, base, radix_level(base, magnitude.size()), 0);
+}
+
+inline Integer Integer::parse_digits(std::string_view digits, uint32_t base) {
+    const auto chunk_digits = detail::digit_chunk<data_t>(base).second;
+    if (digits.size() < from_string_threshold * chunk_digits) {
+        Integer result(0);
+        const char* pos = digits.data();
+        const char* const last = digits.data() + digits.size();
+        while (pos != last) {
+            data_t chunk = 0;
+            data_t scale = 1;
+            pos = detail::accumulate_digits(pos, last, base, chunk, scale);
+            multiply_add_limb(result.m_limbs, scale, chunk);
+        }
+        result.m_limbs.normalize();
+        return result;
+    }
+
+    std::size_t k = 0;
+    while ((chunk_digits << (k + 1)) < digits.size()) {
+        k += 1;
+    }
+    const auto& power = radix_power(base, k);
+    const auto split = digits.size() - power.digits;
+    Integer high;
+    Integer low;
+    detail::parallel_invoke(
+        2 * power.power.size(), [&] { high = parse_digits(digits.substr(0, split), base); },
+        [&] { low = parse_digits(digits.substr(split), base); });
+    high *= power.power;
+    return high += low;
+}
+
+// Multiplies values by a fixed operand. Products large enough for the number theoretic transform reuse the transform
+// of the operand, which is only recomputed when a product needs a different transform length.
+class Multiplier {
+public:
+    explicit Multiplier(Integer operand) : m_operand(std::move(operand)) {}
+
+    const Integer& operand() const { return m_operand; }
+
+    Integer multiply(const Integer& value) {
+        using thresholds = multiplication_thresholds<Integer::data_t>;
+        if (std::min(m_operand.size(), value.size()) < thresholds::ntt) {
+            return m_operand * value;
+        }
+
+        const std::size_t size = detail::NttTransform::size_for(m_operand.size(), value.size());
+        if (m_transform.size() != size) {
+            m_transform = detail::NttTransform(m_operand.limbs(), size);
+        }
+
+        Integer result;
+        result.m_limbs.resize(m_operand.size() + value.size());
+        detail::NttTransform::multiply(result.m_limbs.span(), m_transform, detail::NttTransform(value.limbs(), size));
+        result.m_limbs.normalize();
+        result.m_negative = m_operand.m_negative != value.m_negative && !result.m_limbs.empty();
+        return result;
+    }
+
+private:
+    Integer m_operand;
+    detail::NttTransform m_transform;
+};
+
+} // namespace aba
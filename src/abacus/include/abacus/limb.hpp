@@ -0,0 +1,179 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace aba {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+namespace detail {
+
+// Unsigned integer type twice as wide as Limb, or void if there is none.
+template <typename Limb>
+struct double_limb {
+    using type = void;
+};
+
+template <>
+struct double_limb<uint32_t> {
+    using type = uint64_t;
+};
+
+#if defined(__SIZEOF_INT128__)
+template <>
+struct double_limb<uint64_t> {
+    using type = uint128_t;
+};
+#endif
+
+template <typename Limb>
+using double_limb_t = typename double_limb<Limb>::type;
+
+template <typename Limb>
+constexpr bool has_double_limb_v = !std::is_void_v<double_limb_t<Limb>>;
+
+template <typename Limb>
+constexpr uint32_t limb_bits = std::numeric_limits<Limb>::digits;
+
+// Full product of two limbs, computed from half limbs.
+template <typename Limb>
+constexpr std::pair<Limb, Limb> portable_mul_wide(Limb lhs, Limb rhs) {
+    constexpr uint32_t half = limb_bits<Limb> / 2;
+    constexpr Limb mask = (Limb{1} << half) - 1;
+
+    const Limb lhs_low = lhs & mask;
+    const Limb lhs_high = lhs >> half;
+    const Limb rhs_low = rhs & mask;
+    const Limb rhs_high = rhs >> half;
+
+    const Limb low_low = lhs_low * rhs_low;
+    const Limb high_low = lhs_high * rhs_low;
+    const Limb low_high = lhs_low * rhs_high;
+    const Limb high_high = lhs_high * rhs_high;
+
+    const Limb middle = (low_low >> half) + (high_low & mask) + low_high;
+    const Limb low = (middle << half) | (low_low & mask);
+    const Limb high = high_high + (high_low >> half) + (middle >> half);
+
+    return {low, high};
+}
+
+// Divides the two limb value (high, low) by divisor, high must be less than divisor. Hacker's Delight (2nd ed.),
+// figure 9-3.
+template <typename Limb>
+constexpr std::pair<Limb, Limb> portable_div_wide(Limb high, Limb low, Limb divisor) {
+    constexpr uint32_t bits = limb_bits<Limb>;
+    constexpr uint32_t half = bits / 2;
+    constexpr Limb half_base = Limb{1} << half;
+    constexpr Limb mask = half_base - 1;
+
+    const auto shift = static_cast<uint32_t>(std::countl_zero(divisor));
+    divisor = static_cast<Limb>(divisor << shift);
+
+    const Limb divisor_high = divisor >> half;
+    const Limb divisor_low = divisor & mask;
+
+    const Limb numerator_high = shift != 0 ? static_cast<Limb>((high << shift) | (low >> (bits - shift))) : high;
+    const Limb numerator_low = static_cast<Limb>(low << shift);
+    const Limb numerator_1 = numerator_low >> half;
+    const Limb numerator_0 = numerator_low & mask;
+
+    auto estimate = [&](Limb numerator, Limb next) {
+        Limb q = numerator / divisor_high;
+        Limb rhat = numerator - q * divisor_high;
+        while (q >= half_base || q * divisor_low > ((rhat << half) | next)) {
+            q -= 1;
+            rhat += divisor_high;
+            if (rhat >= half_base) {
+                break;
+            }
+        }
+        return q;
+    };
+
+    const Limb q1 = estimate(numerator_high, numerator_1);
+    const Limb numerator_21 = static_cast<Limb>((numerator_high << half) + numerator_1 - q1 * divisor);
+    const Limb q0 = estimate(numerator_21, numerator_0);
+    const Limb remainder = static_cast<Limb>((numerator_21 << half) + numerator_0 - q0 * divisor) >> shift;
+
+    return {static_cast<Limb>((q1 << half) | q0), remainder};
+}
+
+// Returns {low, high} of lhs * rhs.
+template <typename Limb>
+constexpr std::pair<Limb, Limb> mul_wide(Limb lhs, Limb rhs) {
+    if constexpr (has_double_limb_v<Limb>) {
+        using double_t = double_limb_t<Limb>;
+        const double_t product = static_cast<double_t>(lhs) * rhs;
+        return {static_cast<Limb>(product), static_cast<Limb>(product >> limb_bits<Limb>)};
+    } else {
+        return portable_mul_wide(lhs, rhs);
+    }
+}
+
+// Returns {quotient, remainder} of (high, low) / divisor, high must be less than divisor.
+template <typename Limb>
+constexpr std::pair<Limb, Limb> div_wide(Limb high, Limb low, Limb divisor) {
+    if constexpr (has_double_limb_v<Limb>) {
+        using double_t = double_limb_t<Limb>;
+        const double_t numerator = (static_cast<double_t>(high) << limb_bits<Limb>) | low;
+        return {static_cast<Limb>(numerator / divisor), static_cast<Limb>(numerator % divisor)};
+    } else {
+        return portable_div_wide(high, low, divisor);
+    }
+}
+
+// Returns lhs + rhs + carry, carry (0 or 1) is updated with the carry out.
+template <typename Limb>
+constexpr Limb add_carry(Limb lhs, Limb rhs, Limb& carry) {
+    const Limb sum = static_cast<Limb>(lhs + rhs);
+    const Limb result = static_cast<Limb>(sum + carry);
+    carry = (sum < lhs || result < sum) ? 1 : 0;
+    return result;
+}
+
+// Returns lhs - rhs - borrow, borrow (0 or 1) is updated with the borrow out.
+template <typename Limb>
+constexpr Limb sub_borrow(Limb lhs, Limb rhs, Limb& borrow) {
+    const Limb difference = static_cast<Limb>(lhs - rhs);
+    const Limb result = static_cast<Limb>(difference - borrow);
+    borrow = (lhs < rhs || difference < borrow) ? 1 : 0;
+    return result;
+}
+
+// floor((B^2 - 1) / divisor) - B for a normalized divisor (top bit set), the reciprocal used by div_preinv().
+template <typename Limb>
+constexpr Limb reciprocal_word(Limb divisor) {
+    return div_wide(static_cast<Limb>(~divisor), static_cast<Limb>(~Limb{0}), divisor).first;
+}
+
+// Division of (high, low) by a normalized divisor with its reciprocal_word(), for high < divisor. Returns the quotient
+// and the remainder with two multiplications and no division (Moller and Granlund, "Improved division by invariant
+// integers", 2011, algorithm 4).
+template <typename Limb>
+constexpr std::pair<Limb, Limb> div_preinv(Limb high, Limb low, Limb divisor, Limb reciprocal) {
+    auto [quotient_low, quotient] = mul_wide(reciprocal, high);
+    Limb carry = 0;
+    quotient_low = add_carry(quotient_low, low, carry);
+    quotient = static_cast<Limb>(quotient + high + 1 + carry);
+
+    auto remainder = static_cast<Limb>(low - quotient * divisor);
+    if (remainder > quotient_low) {
+        quotient -= 1;
+        remainder = static_cast<Limb>(remainder + divisor);
+    }
+    if (remainder >= divisor) {
+        quotient += 1;
+        remainder = static_cast<Limb>(remainder - divisor);
+    }
+    return {quotient, remainder};
+}
+
+} // namespace detail
+} // namespace aba
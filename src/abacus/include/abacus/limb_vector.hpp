@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace aba::detail {
+
+// Vector of limbs which keeps up to InlineCapacity limbs inside the object itself and only allocates once it grows
+// beyond that. Growing never shrinks the capacity, new limbs are zero initialized.
+template <typename Limb, std::size_t InlineCapacity>
+class LimbVector {
+public:
+    LimbVector() = default;
+
+    explicit LimbVector(std::size_t size) { resize(size); }
+
+    LimbVector(const LimbVector& other) { *this = other; }
+
+    LimbVector(LimbVector&& other) noexcept { *this = std::move(other); }
+
+    LimbVector& operator=(const LimbVector& other) {
+        if (this != &other) {
+            m_size = 0;
+            reserve(other.m_size);
+            std::copy(other.data(), other.data() + other.m_size, data());
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+
+    LimbVector& operator=(LimbVector&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (other.m_heap) {
+            m_heap = std::move(other.m_heap);
+            m_capacity = other.m_capacity;
+        } else {
+            m_heap.reset();
+            m_capacity = InlineCapacity;
+            m_inline = other.m_inline;
+        }
+        m_size = other.m_size;
+
+        other.m_size = 0;
+        other.m_capacity = InlineCapacity;
+        return *this;
+    }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    std::size_t capacity() const { return m_capacity; }
+    bool is_inline() const { return !m_heap; }
+
+    Limb* data() { return m_heap ? m_heap.get() : m_inline.data(); }
+    const Limb* data() const { return m_heap ? m_heap.get() : m_inline.data(); }
+
+    Limb* begin() { return data(); }
+    Limb* end() { return data() + m_size; }
+    const Limb* begin() const { return data(); }
+    const Limb* end() const { return data() + m_size; }
+
+    Limb& operator[](std::size_t index) { return data()[index]; }
+    const Limb& operator[](std::size_t index) const { return data()[index]; }
+
+    Limb& back() { return data()[m_size - 1]; }
+    const Limb& back() const { return data()[m_size - 1]; }
+
+    std::span<Limb> span() { return {data(), m_size}; }
+    std::span<const Limb> span() const { return {data(), m_size}; }
+
+    void reserve(std::size_t capacity) {
+        if (capacity <= m_capacity) {
+            return;
+        }
+
+        // Grow geometrically so that repeated push_back/resize stays amortized linear.
+        capacity = std::max(capacity, m_capacity + m_capacity / 2);
+        auto heap = std::make_unique<Limb[]>(capacity);
+        std::copy(data(), data() + m_size, heap.get());
+        m_heap = std::move(heap);
+        m_capacity = capacity;
+    }
+
+    void resize(std::size_t size) {
+        reserve(size);
+        if (size > m_size) {
+            std::fill(data() + m_size, data() + size, Limb{0});
+        }
+        m_size = size;
+    }
+
+    void push_back(Limb value) {
+        reserve(m_size + 1);
+        data()[m_size] = value;
+        m_size += 1;
+    }
+
+    void clear() { m_size = 0; }
+
+    // Drops leading (most significant) zero limbs.
+    void normalize() {
+        while (m_size > 0 && data()[m_size - 1] == 0) {
+            m_size -= 1;
+        }
+    }
+
+private:
+    std::unique_ptr<Limb[]> m_heap;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = InlineCapacity;
+    std::array<Limb, InlineCapacity> m_inline{};
+};
+
+} // namespace aba::detail
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
+
+#include "big_int.hpp"
+#include "limb.hpp"
+#include "mpn.hpp"
+#include "multiplication.hpp"
+
+namespace aba {
+
+template <typename T>
+class Modulus;
+
+// Arithmetic modulo a fixed modulus, with the constants for the reductions computed once. Single products are reduced
+// with Barrett's method, which works for every modulus. Exponentiation of an odd modulus runs in Montgomery form,
+// which replaces the division by the modulus with multiplications and a shift.
+//
+// All operations work on the k = significant limbs of the modulus only, operands do not have to be reduced.
+template <std::size_t Limbs, typename Limb>
+class Modulus<BigUIntN<Limbs, Limb>> {
+public:
+    using value_t = BigUIntN<Limbs, Limb>;
+
+    constexpr explicit Modulus(const value_t& modulus) : m_modulus(modulus) {
+        m_size = detail::trim<Limb>(modulus.limbs()).size();
+        if (m_size == 0) {
+            throw std::invalid_argument("Modulus must not be zero");
+        }
+
+        // mu = floor((B^2k - 1) / modulus), which has at most k + 1 limbs as the top limb of the modulus is non-zero.
+        // It is only smaller than floor(B^2k / modulus) for a power of two modulus, which costs barrett() at most one
+        // more correction.
+        std::array<Limb, 2 * Limbs> numerator{};
+        std::fill_n(numerator.begin(), 2 * m_size, ~Limb{0});
+        std::array<Limb, 2 * Limbs> quotient{};
+        std::array<Limb, Limbs> remainder{};
+        divide(quotient, remainder, std::span<const Limb>(numerator).first(2 * m_size));
+        std::copy_n(quotient.begin(), m_size + 1, m_mu.begin());
+
+        if ((modulus.limbs()[0] & 1) != 0) {
+            // -modulus^-1 mod B by Newton's iteration, every step doubles the number of correct low bits (the start
+            // value is correct to 3 bits for every odd number).
+            const Limb low = modulus.limbs()[0];
+            Limb inverse = low;
+            for (std::size_t bits = 3; bits < detail::limb_bits<Limb>; bits *= 2) {
+                inverse = static_cast<Limb>(inverse * static_cast<Limb>(2 - low * inverse));
+            }
+            m_inverse = static_cast<Limb>(Limb{0} - inverse);
+
+            // R^2 mod modulus for R = B^k, which converts into Montgomery form with a single multiplication.
+            const Limb one = 1;
+            const auto r_squared = std::span(remainder).first(m_size);
+            detail::add_in_place<Limb>(r_squared, std::span(&one, 1));
+            if (detail::cmp<Limb>(r_squared, limbs(modulus)) == 0) {
+                std::fill(r_squared.begin(), r_squared.end(), Limb{0});
+            }
+            m_r_squared = value_t(remainder);
+        }
+    }
+
+    constexpr const value_t& modulus() const { return m_modulus; }
+
+    // True if powmod() uses Montgomery multiplication, i.e. the modulus is odd.
+    constexpr bool is_montgomery() const { return m_inverse != 0; }
+
+    // value mod modulus.
+    constexpr value_t reduce(const value_t& value) const {
+        if (detail::trim<Limb>(value.limbs()).size() <= m_size) {
+            std::array<Limb, 2 * Limbs> wide{};
+            std::copy_n(value.limbs().begin(), m_size, wide.begin());
+            return barrett(wide);
+        }
+        return value % m_modulus;
+    }
+
+    constexpr value_t mulmod(const value_t& lhs, const value_t& rhs) const {
+        std::array<Limb, 2 * Limbs> product{};
+        multiply(product, reduced(lhs), reduced(rhs));
+        return barrett(product);
+    }
+
+    constexpr value_t sqrmod(const value_t& value) const {
+        std::array<Limb, 2 * Limbs> product{};
+        square(product, reduced(value));
+        return barrett(product);
+    }
+
+    // base^exponent mod modulus for an exponent of any size, given as its limbs.
+    constexpr value_t powmod(const value_t& base, std::span<const Limb> exponent) const {
+        if (is_montgomery()) {
+            const value_t result = power(to_montgomery(reduced(base)), exponent, to_montgomery(reduce(value_t(1))),
+                                         [this](const value_t& lhs, const value_t& rhs) {
+                                             return montgomery_mul(lhs, rhs);
+                                         });
+            return from_montgomery(result);
+        }
+        return power(reduced(base), exponent, reduce(value_t(1)),
+                     [this](const value_t& lhs, const value_t& rhs) {
+                         return &lhs == &rhs ? sqrmod(lhs) : mulmod(lhs, rhs);
+                     });
+    }
+
+    template <std::size_t ExponentLimbs>
+    constexpr value_t powmod(const value_t& base, const BigUIntN<ExponentLimbs, Limb>& exponent) const {
+        return powmod(base, exponent.limbs());
+    }
+
+private:
+    // Number of bits of the exponent above which the next larger window pays off, the precomputed table holds
+    // 2^(window - 1) odd powers.
+    static constexpr std::array<std::size_t, 5> window_thresholds = {7, 25, 81, 241, 673};
+    static constexpr std::size_t max_window = window_thresholds.size() + 1;
+
+    // Sliding window exponentiation: the exponent is cut into windows of up to `window` bits that start and end with
+    // a one bit, each window costs one multiplication with a precomputed odd power of the base.
+    template <typename Multiply>
+    static constexpr value_t power(const value_t& base, std::span<const Limb> exponent, const value_t& one,
+                                   Multiply multiply) {
+        const auto trimmed = detail::trim<Limb>(exponent);
+        if (trimmed.empty()) {
+            return one;
+        }
+
+        const std::size_t bits = trimmed.size() * detail::limb_bits<Limb> -
+                                 static_cast<std::size_t>(std::countl_zero(trimmed.back()));
+        auto bit = [&trimmed](std::size_t i) {
+            return ((trimmed[i / detail::limb_bits<Limb>] >> (i % detail::limb_bits<Limb>)) & 1) != 0;
+        };
+
+        std::size_t window = 1;
+        while (window < max_window && bits > window_thresholds[window - 1]) {
+            window += 1;
+        }
+
+        // odd_powers[i] = base^(2i + 1).
+        std::array<value_t, std::size_t{1} << (max_window - 1)> odd_powers{};
+        odd_powers[0] = base;
+        const std::size_t table_size = std::size_t{1} << (window - 1);
+        if (table_size > 1) {
+            const value_t base_squared = multiply(base, base);
+            for (std::size_t i = 1; i < table_size; ++i) {
+                odd_powers[i] = multiply(odd_powers[i - 1], base_squared);
+            }
+        }
+
+        value_t result = one;
+        bool first = true;
+        std::size_t end = bits;
+        while (end > 0) {
+            if (!bit(end - 1)) {
+                result = multiply(result, result);
+                end -= 1;
+                continue;
+            }
+
+            // The window [start, end) is as long as possible and ends in a one bit.
+            std::size_t start = end > window ? end - window : 0;
+            while (!bit(start)) {
+                start += 1;
+            }
+            std::size_t index = 0;
+            for (std::size_t i = end; i > start; --i) {
+                index = (index << 1) | (bit(i - 1) ? 1 : 0);
+            }
+
+            if (first) {
+                result = odd_powers[index >> 1];
+                first = false;
+            } else {
+                for (std::size_t i = start; i < end; ++i) {
+                    result = multiply(result, result);
+                }
+                result = multiply(result, odd_powers[index >> 1]);
+            }
+            end = start;
+        }
+        return result;
+    }
+
+    constexpr std::span<const Limb> limbs(const value_t& value) const { return value.limbs().first(m_size); }
+
+    constexpr value_t reduced(const value_t& value) const { return value < m_modulus ? value : reduce(value); }
+
+    // result = lhs * rhs for values below the modulus, result holds 2k limbs.
+    constexpr void multiply(std::span<Limb> result, const value_t& lhs, const value_t& rhs) const {
+        detail::mul_basecase<Limb>(result.first(2 * m_size), limbs(lhs), limbs(rhs));
+    }
+
+    constexpr void square(std::span<Limb> result, const value_t& value) const {
+        detail::sqr_basecase<Limb>(result.first(2 * m_size), limbs(value));
+    }
+
+    // quotient = numerator / modulus and remainder = numerator mod modulus (k limbs).
+    constexpr void divide(std::span<Limb> quotient, std::span<Limb> remainder,
+                          std::span<const Limb> numerator) const {
+        if (m_size == 1) {
+            remainder[0] = detail::divrem_1<Limb>(quotient.first(numerator.size()), numerator, m_modulus.limbs()[0]);
+            return;
+        }
+        std::array<Limb, 3 * Limbs + 2> scratch{};
+        detail::divrem<Limb>(quotient.first(numerator.size() - m_size + 1), remainder.first(m_size), numerator,
+                             limbs(m_modulus), scratch);
+    }
+
+    // Barrett reduction of a value below B^2k, see HAC 14.42: the quotient estimated from the top limbs with mu is at
+    // most three too small.
+    constexpr value_t barrett(std::span<const Limb> value) const {
+        // The constructor guarantees 1 <= m_size <= Limbs, the clamp only states it so the compiler can see the bounds
+        // of every span below (otherwise GCC warns about the k = 0 case with -Wstringop-overflow).
+        const std::size_t k = std::clamp<std::size_t>(m_size, 1, Limbs);
+
+        // q = floor(floor(value / B^(k - 1)) * mu / B^(k + 1))
+        std::array<Limb, 2 * Limbs + 2> product{};
+        detail::mul_basecase<Limb>(std::span(product).first(2 * k + 2), value.subspan(k - 1, k + 1),
+                                   std::span<const Limb>(m_mu).first(k + 1));
+        const auto quotient = std::span<const Limb>(product).subspan(k + 1, k + 1);
+
+        // r = value - q * modulus mod B^(k + 1)
+        std::array<Limb, 2 * Limbs + 1> estimate{};
+        detail::mul_basecase<Limb>(std::span(estimate).first(2 * k + 1), quotient, limbs(m_modulus));
+        std::array<Limb, Limbs + 1> remainder{};
+        detail::sub_n<Limb>(std::span(remainder).first(k + 1), value.first(k + 1),
+                            std::span<const Limb>(estimate).first(k + 1));
+
+        std::array<Limb, Limbs + 1> modulus{};
+        std::copy_n(m_modulus.limbs().begin(), k, modulus.begin());
+        const auto r = std::span(remainder).first(k + 1);
+        const auto m = std::span<const Limb>(modulus).first(k + 1);
+        while (detail::cmp<Limb>(r, m) >= 0) {
+            detail::sub_n<Limb>(r, r, m);
+        }
+
+        std::array<Limb, Limbs> data{};
+        std::copy_n(remainder.begin(), k, data.begin());
+        return value_t(data);
+    }
+
+    // Montgomery reduction: value * R^-1 mod modulus for value < modulus * R, value holds 2k + 1 limbs and is
+    // overwritten. Adding a multiple of the modulus clears one low limb at a time.
+    constexpr value_t redc(std::span<Limb> value) const {
+        const std::size_t k = m_size;
+        for (std::size_t i = 0; i < k; ++i) {
+            const auto factor = static_cast<Limb>(value[i] * m_inverse);
+            const Limb carry = detail::addmul_1<Limb>(value.subspan(i, k), limbs(m_modulus), factor);
+            detail::add_in_place<Limb>(value.subspan(i + k), std::span(&carry, 1));
+        }
+
+        // The result value / R is below 2 * modulus.
+        std::array<Limb, Limbs> data{};
+        const auto result = std::span(data).first(k);
+        std::copy_n(value.begin() + static_cast<std::ptrdiff_t>(k), k, result.begin());
+        if (value[2 * k] != 0 || detail::cmp<Limb>(result, limbs(m_modulus)) >= 0) {
+            detail::sub_n<Limb>(result, result, limbs(m_modulus));
+        }
+        return value_t(data);
+    }
+
+    constexpr value_t montgomery_mul(const value_t& lhs, const value_t& rhs) const {
+        std::array<Limb, 2 * Limbs + 1> product{};
+        if (&lhs == &rhs) {
+            square(product, lhs);
+        } else {
+            multiply(product, lhs, rhs);
+        }
+        return redc(std::span(product).first(2 * m_size + 1));
+    }
+
+    constexpr value_t to_montgomery(const value_t& value) const { return montgomery_mul(value, m_r_squared); }
+
+    constexpr value_t from_montgomery(const value_t& value) const {
+        std::array<Limb, 2 * Limbs + 1> wide{};
+        std::copy_n(value.limbs().begin(), m_size, wide.begin());
+        return redc(std::span(wide).first(2 * m_size + 1));
+    }
+
+    value_t m_modulus;
+    std::size_t m_size = 0;
+    std::array<Limb, Limbs + 1> m_mu{};
+    Limb m_inverse = 0;
+    value_t m_r_squared = value_t(0);
+};
+
+} // namespace aba
@@ -0,0 +1,703 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "cpu.hpp"
+#include "limb.hpp"
+
+// Kernels on little endian limb spans which all multi-limb arithmetic is built on, modelled after the mpn layer of
+// GMP. The operands have the same size, which is the length of the operation, result holds at least as many limbs and
+// may be the same span as an operand.
+//
+// Every kernel has a portable constexpr version, used in constant evaluation and for 32-bit limbs. For 64-bit limbs
+// the native kernels of kernel_table() are used, chosen at runtime for the CPU (see cpu_kernels()).
+namespace aba::detail {
+
+namespace portable {
+
+template <typename Limb>
+constexpr Limb add_n(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        result[i] = add_carry(lhs[i], rhs[i], carry);
+    }
+    return carry;
+}
+
+template <typename Limb>
+constexpr Limb sub_n(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    Limb borrow = 0;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        result[i] = sub_borrow(lhs[i], rhs[i], borrow);
+    }
+    return borrow;
+}
+
+template <typename Limb>
+constexpr Limb mul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const auto [low, high] = mul_wide(value[i], factor);
+        Limb overflow = 0;
+        result[i] = add_carry(low, carry, overflow);
+        carry = static_cast<Limb>(high + overflow);
+    }
+    return carry;
+}
+
+template <typename Limb>
+constexpr Limb addmul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        auto [low, high] = mul_wide(value[i], factor);
+        Limb overflow = 0;
+        low = add_carry(low, carry, overflow);
+        high = static_cast<Limb>(high + overflow);
+        overflow = 0;
+        result[i] = add_carry(result[i], low, overflow);
+        carry = static_cast<Limb>(high + overflow);
+    }
+    return carry;
+}
+
+template <typename Limb>
+constexpr Limb submul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+    Limb carry = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        auto [low, high] = mul_wide(value[i], factor);
+        Limb overflow = 0;
+        low = add_carry(low, carry, overflow);
+        high = static_cast<Limb>(high + overflow);
+        Limb borrow = 0;
+        result[i] = sub_borrow(result[i], low, borrow);
+        carry = static_cast<Limb>(high + borrow);
+    }
+    return carry;
+}
+
+} // namespace portable
+
+#if defined(__SIZEOF_INT128__)
+namespace native {
+
+inline uint64_t add_carry(uint64_t lhs, uint64_t rhs, unsigned char& carry) {
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned long long result = 0;
+    carry = _addcarry_u64(carry, lhs, rhs, &result);
+    return result;
+#else
+    const uint128_t sum = uint128_t{lhs} + rhs + carry;
+    carry = static_cast<unsigned char>(sum >> 64);
+    return static_cast<uint64_t>(sum);
+#endif
+}
+
+inline uint64_t sub_borrow(uint64_t lhs, uint64_t rhs, unsigned char& borrow) {
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned long long result = 0;
+    borrow = _subborrow_u64(borrow, lhs, rhs, &result);
+    return result;
+#else
+    const uint128_t difference = uint128_t{lhs} - rhs - borrow;
+    borrow = static_cast<unsigned char>((difference >> 64) & 1);
+    return static_cast<uint64_t>(difference);
+#endif
+}
+
+inline uint64_t add_n(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n) {
+    unsigned char carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        result[i] = add_carry(lhs[i], rhs[i], carry);
+    }
+    return carry;
+}
+
+inline uint64_t sub_n(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n) {
+    unsigned char borrow = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        result[i] = sub_borrow(lhs[i], rhs[i], borrow);
+    }
+    return borrow;
+}
+
+// The 128-bit sums below can not overflow: (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1.
+inline uint64_t mul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint128_t product = uint128_t{value[i]} * factor + carry;
+        result[i] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+    }
+    return carry;
+}
+
+inline uint64_t addmul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint128_t product = uint128_t{value[i]} * factor + result[i] + carry;
+        result[i] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+    }
+    return carry;
+}
+
+inline uint64_t submul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const uint128_t product = uint128_t{value[i]} * factor + carry;
+        const auto low = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64) + (result[i] < low ? 1 : 0);
+        result[i] -= low;
+    }
+    return carry;
+}
+
+} // namespace native
+#endif
+
+#if ABACUS_X86_KERNELS
+// Kernels for CPUs with BMI2 and ADX, only called once cpu_kernels() has checked for them. mulx leaves the flags alone,
+// which lets the carries of the products (adcx, the carry flag) and of the accumulation (adox, the overflow flag) run
+// as two independent chains through the whole loop. The loops count with lea and jrcxz which do not touch the flags
+// either, the first loop handles n % 4 limbs and the second four limbs at a time. Both are entered at their test.
+namespace adx {
+
+inline uint64_t add_n(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n) {
+    std::size_t count = n % 4;
+    uint64_t carry = 0;
+    uint64_t limb = 0;
+    asm volatile("xor %k[limb], %k[limb]\n\t"
+                 "jmp 5f\n"
+                 "1:\n\t"
+                 "mov (%[lhs]), %[limb]\n\t"
+                 "adcx (%[rhs]), %[limb]\n\t"
+                 "mov %[limb], (%[result])\n\t"
+                 "lea 8(%[lhs]), %[lhs]\n\t"
+                 "lea 8(%[rhs]), %[rhs]\n\t"
+                 "lea 8(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "5:\n\t"
+                 "jrcxz 2f\n\t"
+                 "jmp 1b\n"
+                 "2:\n\t"
+                 "mov %[blocks], %[count]\n\t"
+                 "jmp 6f\n"
+                 "3:\n\t"
+                 ".irp k, 0, 8, 16, 24\n\t"
+                 "mov \\k(%[lhs]), %[limb]\n\t"
+                 "adcx \\k(%[rhs]), %[limb]\n\t"
+                 "mov %[limb], \\k(%[result])\n\t"
+                 ".endr\n\t"
+                 "lea 32(%[lhs]), %[lhs]\n\t"
+                 "lea 32(%[rhs]), %[rhs]\n\t"
+                 "lea 32(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "6:\n\t"
+                 "jrcxz 4f\n\t"
+                 "jmp 3b\n"
+                 "4:\n\t"
+                 "adcx %[count], %[carry]"
+                 : [result] "+&r"(result), [lhs] "+&r"(lhs), [rhs] "+&r"(rhs), [count] "+&c"(count),
+                   [carry] "+&r"(carry), [limb] "=&r"(limb)
+                 : [blocks] "r"(n / 4)
+                 : "cc", "memory");
+    return carry;
+}
+
+inline uint64_t sub_n(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n) {
+    std::size_t count = n % 4;
+    uint64_t borrow = 0;
+    uint64_t limb = 0;
+    asm volatile("xor %k[limb], %k[limb]\n\t"
+                 "jmp 5f\n"
+                 "1:\n\t"
+                 "mov (%[lhs]), %[limb]\n\t"
+                 "sbb (%[rhs]), %[limb]\n\t"
+                 "mov %[limb], (%[result])\n\t"
+                 "lea 8(%[lhs]), %[lhs]\n\t"
+                 "lea 8(%[rhs]), %[rhs]\n\t"
+                 "lea 8(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "5:\n\t"
+                 "jrcxz 2f\n\t"
+                 "jmp 1b\n"
+                 "2:\n\t"
+                 "mov %[blocks], %[count]\n\t"
+                 "jmp 6f\n"
+                 "3:\n\t"
+                 ".irp k, 0, 8, 16, 24\n\t"
+                 "mov \\k(%[lhs]), %[limb]\n\t"
+                 "sbb \\k(%[rhs]), %[limb]\n\t"
+                 "mov %[limb], \\k(%[result])\n\t"
+                 ".endr\n\t"
+                 "lea 32(%[lhs]), %[lhs]\n\t"
+                 "lea 32(%[rhs]), %[rhs]\n\t"
+                 "lea 32(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "6:\n\t"
+                 "jrcxz 4f\n\t"
+                 "jmp 3b\n"
+                 "4:\n\t"
+                 "adcx %[count], %[borrow]"
+                 : [result] "+&r"(result), [lhs] "+&r"(lhs), [rhs] "+&r"(rhs), [count] "+&c"(count),
+                   [borrow] "+&r"(borrow), [limb] "=&r"(limb)
+                 : [blocks] "r"(n / 4)
+                 : "cc", "memory");
+    return borrow;
+}
+
+inline uint64_t mul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    std::size_t count = n % 4;
+    uint64_t carry = 0;
+    uint64_t low = 0;
+    uint64_t high = 0;
+    asm volatile("xor %k[low], %k[low]\n\t"
+                 "jmp 5f\n"
+                 "1:\n\t"
+                 "mulx (%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "mov %[low], (%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 "lea 8(%[value]), %[value]\n\t"
+                 "lea 8(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "5:\n\t"
+                 "jrcxz 2f\n\t"
+                 "jmp 1b\n"
+                 "2:\n\t"
+                 "mov %[blocks], %[count]\n\t"
+                 "jmp 6f\n"
+                 "3:\n\t"
+                 ".irp k, 0, 8, 16, 24\n\t"
+                 "mulx \\k(%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "mov %[low], \\k(%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 ".endr\n\t"
+                 "lea 32(%[value]), %[value]\n\t"
+                 "lea 32(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "6:\n\t"
+                 "jrcxz 4f\n\t"
+                 "jmp 3b\n"
+                 "4:\n\t"
+                 "adcx %[count], %[carry]"
+                 : [result] "+&r"(result), [value] "+&r"(value), [count] "+&c"(count), [carry] "+&r"(carry),
+                   [low] "=&r"(low), [high] "=&r"(high)
+                 : [blocks] "r"(n / 4), [factor] "d"(factor)
+                 : "cc", "memory");
+    return carry;
+}
+
+inline uint64_t addmul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    std::size_t count = n % 4;
+    uint64_t carry = 0;
+    uint64_t low = 0;
+    uint64_t high = 0;
+    asm volatile("xor %k[low], %k[low]\n\t"
+                 "jmp 5f\n"
+                 "1:\n\t"
+                 "mulx (%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "adox (%[result]), %[low]\n\t"
+                 "mov %[low], (%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 "lea 8(%[value]), %[value]\n\t"
+                 "lea 8(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "5:\n\t"
+                 "jrcxz 2f\n\t"
+                 "jmp 1b\n"
+                 "2:\n\t"
+                 "mov %[blocks], %[count]\n\t"
+                 "jmp 6f\n"
+                 "3:\n\t"
+                 ".irp k, 0, 8, 16, 24\n\t"
+                 "mulx \\k(%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "adox \\k(%[result]), %[low]\n\t"
+                 "mov %[low], \\k(%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 ".endr\n\t"
+                 "lea 32(%[value]), %[value]\n\t"
+                 "lea 32(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "6:\n\t"
+                 "jrcxz 4f\n\t"
+                 "jmp 3b\n"
+                 "4:\n\t"
+                 "adcx %[count], %[carry]\n\t"
+                 "adox %[count], %[carry]"
+                 : [result] "+&r"(result), [value] "+&r"(value), [count] "+&c"(count), [carry] "+&r"(carry),
+                   [low] "=&r"(low), [high] "=&r"(high)
+                 : [blocks] "r"(n / 4), [factor] "d"(factor)
+                 : "cc", "memory");
+    return carry;
+}
+
+// The difference is formed as ~(~result + value * factor), which turns the borrows into carries for adox.
+inline uint64_t submul_1(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor) {
+    std::size_t count = n % 4;
+    uint64_t carry = 0;
+    uint64_t low = 0;
+    uint64_t high = 0;
+    uint64_t limb = 0;
+    asm volatile("xor %k[low], %k[low]\n\t"
+                 "jmp 5f\n"
+                 "1:\n\t"
+                 "mulx (%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "mov (%[result]), %[limb]\n\t"
+                 "not %[limb]\n\t"
+                 "adox %[low], %[limb]\n\t"
+                 "not %[limb]\n\t"
+                 "mov %[limb], (%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 "lea 8(%[value]), %[value]\n\t"
+                 "lea 8(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "5:\n\t"
+                 "jrcxz 2f\n\t"
+                 "jmp 1b\n"
+                 "2:\n\t"
+                 "mov %[blocks], %[count]\n\t"
+                 "jmp 6f\n"
+                 "3:\n\t"
+                 ".irp k, 0, 8, 16, 24\n\t"
+                 "mulx \\k(%[value]), %[low], %[high]\n\t"
+                 "adcx %[carry], %[low]\n\t"
+                 "mov \\k(%[result]), %[limb]\n\t"
+                 "not %[limb]\n\t"
+                 "adox %[low], %[limb]\n\t"
+                 "not %[limb]\n\t"
+                 "mov %[limb], \\k(%[result])\n\t"
+                 "mov %[high], %[carry]\n\t"
+                 ".endr\n\t"
+                 "lea 32(%[value]), %[value]\n\t"
+                 "lea 32(%[result]), %[result]\n\t"
+                 "lea -1(%[count]), %[count]\n"
+                 "6:\n\t"
+                 "jrcxz 4f\n\t"
+                 "jmp 3b\n"
+                 "4:\n\t"
+                 "adcx %[count], %[carry]\n\t"
+                 "adox %[count], %[carry]"
+                 : [result] "+&r"(result), [value] "+&r"(value), [count] "+&c"(count), [carry] "+&r"(carry),
+                   [low] "=&r"(low), [high] "=&r"(high), [limb] "=&r"(limb)
+                 : [blocks] "r"(n / 4), [factor] "d"(factor)
+                 : "cc", "memory");
+    return carry;
+}
+
+} // namespace adx
+#endif
+
+#if defined(__SIZEOF_INT128__)
+// One variant of the native kernels, see CpuKernels.
+struct KernelTable {
+    uint64_t (*add_n)(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n);
+    uint64_t (*sub_n)(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, std::size_t n);
+    uint64_t (*mul_1)(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor);
+    uint64_t (*addmul_1)(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor);
+    uint64_t (*submul_1)(uint64_t* result, const uint64_t* value, std::size_t n, uint64_t factor);
+};
+
+inline constexpr KernelTable baseline_kernels = {native::add_n, native::sub_n, native::mul_1, native::addmul_1,
+                                                 native::submul_1};
+
+#if ABACUS_X86_KERNELS
+inline constexpr KernelTable adx_kernels = {adx::add_n, adx::sub_n, adx::mul_1, adx::addmul_1, adx::submul_1};
+#endif
+
+// Kernels of the given variant, which the CPU has to support.
+inline const KernelTable& kernel_table(CpuKernels kernels) {
+#if ABACUS_X86_KERNELS
+    if (kernels == CpuKernels::bmi2_adx) {
+        return adx_kernels;
+    }
+#endif
+    static_cast<void>(kernels);
+    return baseline_kernels;
+}
+
+// Kernels chosen for the running CPU.
+inline const KernelTable& kernel_table() {
+    static const KernelTable& table = kernel_table(cpu_kernels());
+    return table;
+}
+#endif
+
+// True if the native kernels are used for Limb outside of constant evaluation.
+template <typename Limb>
+constexpr bool has_native_kernels = has_double_limb_v<Limb> && std::is_same_v<Limb, uint64_t>;
+
+// Operations on fewer limbs call the baseline kernels directly, the runtime choice does not pay for the indirect call.
+inline constexpr std::size_t dispatch_threshold = 8;
+
+// result = lhs + rhs, returns the carry out.
+template <typename Limb>
+constexpr Limb add_n(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+#if defined(__SIZEOF_INT128__)
+    if constexpr (has_native_kernels<Limb>) {
+        if (!std::is_constant_evaluated()) {
+            if (lhs.size() < dispatch_threshold) {
+                return native::add_n(result.data(), lhs.data(), rhs.data(), lhs.size());
+            }
+            return kernel_table().add_n(result.data(), lhs.data(), rhs.data(), lhs.size());
+        }
+    }
+#endif
+    return portable::add_n(result, lhs, rhs);
+}
+
+// result = lhs - rhs, returns the borrow out.
+template <typename Limb>
+constexpr Limb sub_n(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+#if defined(__SIZEOF_INT128__)
+    if constexpr (has_native_kernels<Limb>) {
+        if (!std::is_constant_evaluated()) {
+            if (lhs.size() < dispatch_threshold) {
+                return native::sub_n(result.data(), lhs.data(), rhs.data(), lhs.size());
+            }
+            return kernel_table().sub_n(result.data(), lhs.data(), rhs.data(), lhs.size());
+        }
+    }
+#endif
+    return portable::sub_n(result, lhs, rhs);
+}
+
+// result = value * factor, returns the high limb of the product.
+template <typename Limb>
+constexpr Limb mul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+#if defined(__SIZEOF_INT128__)
+    if constexpr (has_native_kernels<Limb>) {
+        if (!std::is_constant_evaluated()) {
+            if (value.size() < dispatch_threshold) {
+                return native::mul_1(result.data(), value.data(), value.size(), factor);
+            }
+            return kernel_table().mul_1(result.data(), value.data(), value.size(), factor);
+        }
+    }
+#endif
+    return portable::mul_1(result, value, factor);
+}
+
+// result += value * factor, returns the limb carried out.
+template <typename Limb>
+constexpr Limb addmul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+#if defined(__SIZEOF_INT128__)
+    if constexpr (has_native_kernels<Limb>) {
+        if (!std::is_constant_evaluated()) {
+            if (value.size() < dispatch_threshold) {
+                return native::addmul_1(result.data(), value.data(), value.size(), factor);
+            }
+            return kernel_table().addmul_1(result.data(), value.data(), value.size(), factor);
+        }
+    }
+#endif
+    return portable::addmul_1(result, value, factor);
+}
+
+// result -= value * factor, returns the limb borrowed.
+template <typename Limb>
+constexpr Limb submul_1(std::span<Limb> result, std::span<const Limb> value, Limb factor) {
+#if defined(__SIZEOF_INT128__)
+    if constexpr (has_native_kernels<Limb>) {
+        if (!std::is_constant_evaluated()) {
+            if (value.size() < dispatch_threshold) {
+                return native::submul_1(result.data(), value.data(), value.size(), factor);
+            }
+            return kernel_table().submul_1(result.data(), value.data(), value.size(), factor);
+        }
+    }
+#endif
+    return portable::submul_1(result, value, factor);
+}
+
+// result = value << shift for shift < limb_bits<Limb>, returns the bits shifted out at the top (in the low bits). The
+// limbs are processed from the top, so result may also start above value.
+template <typename Limb>
+constexpr Limb lshift(std::span<Limb> result, std::span<const Limb> value, uint32_t shift) {
+    const std::size_t n = result.size();
+    if (n == 0) {
+        return 0;
+    }
+    if (shift == 0) {
+        std::copy_backward(value.begin(), value.begin() + static_cast<std::ptrdiff_t>(n), result.end());
+        return 0;
+    }
+
+    const Limb out = value[n - 1] >> (limb_bits<Limb> - shift);
+    for (std::size_t i = n - 1; i > 0; --i) {
+        result[i] = static_cast<Limb>((value[i] << shift) | (value[i - 1] >> (limb_bits<Limb> - shift)));
+    }
+    result[0] = static_cast<Limb>(value[0] << shift);
+    return out;
+}
+
+// result = value >> shift for shift < limb_bits<Limb>, returns the bits shifted out at the bottom (in the high bits).
+// The limbs are processed from the bottom, so result may also start below value.
+template <typename Limb>
+constexpr Limb rshift(std::span<Limb> result, std::span<const Limb> value, uint32_t shift) {
+    const std::size_t n = result.size();
+    if (n == 0) {
+        return 0;
+    }
+    if (shift == 0) {
+        std::copy(value.begin(), value.begin() + static_cast<std::ptrdiff_t>(n), result.begin());
+        return 0;
+    }
+
+    const auto out = static_cast<Limb>(value[0] << (limb_bits<Limb> - shift));
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        result[i] = static_cast<Limb>((value[i] >> shift) | (value[i + 1] << (limb_bits<Limb> - shift)));
+    }
+    result[n - 1] = value[n - 1] >> shift;
+    return out;
+}
+
+// Compares two values of the same size.
+template <typename Limb>
+constexpr std::strong_ordering cmp(std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    for (std::size_t i = lhs.size(); i > 0; --i) {
+        if (lhs[i - 1] != rhs[i - 1]) {
+            return lhs[i - 1] <=> rhs[i - 1];
+        }
+    }
+    return std::strong_ordering::equal;
+}
+
+// lhs += rhs where rhs is not longer than lhs, returns the carry out of lhs.
+template <typename Limb>
+constexpr Limb add_in_place(std::span<Limb> lhs, std::span<const Limb> rhs) {
+    Limb carry = add_n<Limb>(lhs.first(rhs.size()), lhs.first(rhs.size()), rhs);
+    for (std::size_t i = rhs.size(); carry != 0 && i < lhs.size(); ++i) {
+        lhs[i] = static_cast<Limb>(lhs[i] + 1);
+        carry = lhs[i] == 0 ? 1 : 0;
+    }
+    return carry;
+}
+
+// lhs -= rhs where rhs is not longer than lhs, returns the borrow out of lhs.
+template <typename Limb>
+constexpr Limb sub_in_place(std::span<Limb> lhs, std::span<const Limb> rhs) {
+    Limb borrow = sub_n<Limb>(lhs.first(rhs.size()), lhs.first(rhs.size()), rhs);
+    for (std::size_t i = rhs.size(); borrow != 0 && i < lhs.size(); ++i) {
+        borrow = lhs[i] == 0 ? 1 : 0;
+        lhs[i] = static_cast<Limb>(lhs[i] - 1);
+    }
+    return borrow;
+}
+
+// Returns value without its leading zero limbs.
+template <typename Limb>
+constexpr std::span<const Limb> trim(std::span<const Limb> value) {
+    std::size_t size = value.size();
+    while (size > 0 && value[size - 1] == 0) {
+        size -= 1;
+    }
+    return value.first(size);
+}
+
+// quotient = value / divisor, returns the remainder.
+template <typename Limb>
+constexpr Limb divrem_1(std::span<Limb> quotient, std::span<const Limb> value, Limb divisor) {
+    Limb rem = 0;
+    for (std::size_t i = value.size(); i > 0; --i) {
+        std::tie(quotient[i - 1], rem) = div_wide(rem, value[i - 1], divisor);
+    }
+    return rem;
+}
+
+// value mod divisor, for a divisor != 0.
+template <typename Limb>
+constexpr Limb mod_1(std::span<const Limb> value, Limb divisor) {
+    Limb rem = 0;
+    for (std::size_t i = value.size(); i > 0; --i) {
+        rem = div_wide(rem, value[i - 1], divisor).second;
+    }
+    return rem;
+}
+
+// Knuth, TAOCP vol. 2, 4.3.1, Algorithm D on normalized operands. Divides un (m + 1 limbs, m >= n) by vn (n >= 2 limbs
+// with the top bit set) into quotient (m - n + 1 limbs), for reciprocal = reciprocal_word(vn[n - 1]) and the leading n
+// limbs of un below vn. The remainder is left in un[0, n).
+//
+// The quotient is produced one limb at a time, each estimated with a two-by-one limb division of the leading limbs by
+// the reciprocal and corrected at most twice.
+template <typename Limb>
+constexpr void divrem_normalized(std::span<Limb> quotient, std::span<Limb> un, std::span<const Limb> vn,
+                                 Limb reciprocal) {
+    const std::size_t n = vn.size();
+    const std::size_t m = un.size() - 1;
+
+    for (std::size_t j = m - n + 1; j > 0; --j) {
+        const std::size_t k = j - 1;
+
+        // Estimate the quotient limb from the top two limbs of the window, the top limb is at most vn[n - 1].
+        Limb qhat = std::numeric_limits<Limb>::max();
+        Limb rhat = 0;
+        bool rhat_overflow = false;
+        if (un[k + n] < vn[n - 1]) {
+            std::tie(qhat, rhat) = div_preinv(un[k + n], un[k + n - 1], vn[n - 1], reciprocal);
+        } else {
+            rhat = static_cast<Limb>(un[k + n - 1] + vn[n - 1]);
+            rhat_overflow = rhat < vn[n - 1];
+        }
+
+        while (!rhat_overflow) {
+            const auto [low, high] = mul_wide(qhat, vn[n - 2]);
+            if (high < rhat || (high == rhat && low <= un[k + n - 2])) {
+                break;
+            }
+            qhat -= 1;
+            rhat = static_cast<Limb>(rhat + vn[n - 1]);
+            rhat_overflow = rhat < vn[n - 1];
+        }
+
+        // Multiply and subtract qhat * vn from the current window of un. If the estimate was one too large, add the
+        // divisor back.
+        const auto window = un.subspan(k, n);
+        const Limb borrow = submul_1<Limb>(window, vn, qhat);
+        const bool negative = un[k + n] < borrow;
+        un[k + n] = static_cast<Limb>(un[k + n] - borrow);
+        if (negative) {
+            qhat -= 1;
+            un[k + n] = static_cast<Limb>(un[k + n] + add_n<Limb>(window, window, vn));
+        }
+
+        quotient[k] = qhat;
+    }
+}
+
+// Divides numerator (m limbs) by divisor (n >= 2 limbs with a non-zero top limb), m >= n, into quotient (m - n + 1
+// limbs) and remainder (n limbs) with divrem_normalized(). scratch must hold m + n + 1 limbs.
+template <typename Limb>
+constexpr void divrem(std::span<Limb> quotient, std::span<Limb> remainder, std::span<const Limb> numerator,
+                      std::span<const Limb> divisor, std::span<Limb> scratch) {
+    const std::size_t n = divisor.size();
+    const std::size_t m = numerator.size();
+
+    // Normalize so that the leading limb of the divisor has its top bit set, which makes the estimated quotient limb
+    // at most two too large.
+    const auto shift = static_cast<uint32_t>(std::countl_zero(divisor[n - 1]));
+    const auto un = scratch.first(m + 1);
+    const auto vn = scratch.subspan(m + 1, n);
+    lshift<Limb>(vn, divisor, shift);
+    un[m] = lshift<Limb>(un.first(m), numerator, shift);
+
+    divrem_normalized<Limb>(quotient, un, vn, reciprocal_word(vn[n - 1]));
+    rshift<Limb>(remainder, un.first(n), shift);
+}
+
+} // namespace aba::detail
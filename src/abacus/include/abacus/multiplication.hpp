@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "limb.hpp"
+#include "mpn.hpp"
+#include "ntt.hpp"
+#include "thread_pool.hpp"
+
+namespace aba {
+
+// Operand sizes (in limbs, of the shorter operand) from which the subquadratic algorithms take over from the
+// schoolbook multiplication. Squaring has a cheaper base case and so switches later. The number theoretic transform
+// works on 64-bit limbs only.
+//
+// From ParallelOptions::threshold limbs on, the independent subproducts of the algorithms are computed on the shared
+// thread pool.
+template <typename Limb>
+struct multiplication_thresholds;
+
+template <>
+struct multiplication_thresholds<uint32_t> {
+    static constexpr std::size_t karatsuba = 24;
+    static constexpr std::size_t toom3 = 256;
+    static constexpr std::size_t karatsuba_square = 40;
+    static constexpr std::size_t toom3_square = 256;
+    static constexpr std::size_t ntt = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t ntt_square = std::numeric_limits<std::size_t>::max();
+};
+
+template <>
+struct multiplication_thresholds<uint64_t> {
+    static constexpr std::size_t karatsuba = 32;
+    static constexpr std::size_t toom3 = 256;
+    static constexpr std::size_t karatsuba_square = 48;
+    static constexpr std::size_t toom3_square = 256;
+    static constexpr std::size_t ntt = 3000;
+    static constexpr std::size_t ntt_square = 3000;
+};
+
+namespace detail {
+
+template <typename Limb>
+void multiply(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs);
+
+template <typename Limb>
+void square(std::span<Limb> result, std::span<const Limb> value);
+
+// Schoolbook multiplication, result must hold lhs.size() + rhs.size() limbs.
+template <typename Limb>
+constexpr void mul_basecase(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    std::fill(result.begin(), result.end(), Limb{0});
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        result[i + lhs.size()] = addmul_1<Limb>(result.subspan(i), lhs, rhs[i]);
+    }
+}
+
+// Schoolbook squaring, every cross product a_i * a_j is only computed once and then doubled.
+template <typename Limb>
+constexpr void sqr_basecase(std::span<Limb> result, std::span<const Limb> value) {
+    const std::size_t n = value.size();
+    std::fill(result.begin(), result.end(), Limb{0});
+    if (n == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        result[i + n] = addmul_1<Limb>(result.subspan(2 * i + 1), value.subspan(i + 1), value[i]);
+    }
+
+    lshift<Limb>(result, result, 1);
+
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto [low, high] = mul_wide(value[i], value[i]);
+        result[2 * i] = add_carry(result[2 * i], low, carry);
+        result[2 * i + 1] = add_carry(result[2 * i + 1], high, carry);
+    }
+}
+
+// lhs is at least twice as long as rhs: multiply rhs with rhs.size() sized chunks of lhs. On the thread pool, the
+// products of the low and high halves of the chunks are computed at the same time instead.
+template <typename Limb>
+void mul_unbalanced(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    const std::size_t n = rhs.size();
+    if (is_parallel(n)) {
+        const std::size_t split = (lhs.size() / n + 1) / 2 * n;
+        std::vector<Limb> high(lhs.size() - split + n);
+        parallel_invoke(
+            n, [&] { multiply<Limb>(result.first(split + n), lhs.first(split), rhs); },
+            [&] { multiply<Limb>(high, lhs.subspan(split), rhs); });
+        std::fill(result.begin() + static_cast<std::ptrdiff_t>(split + n), result.end(), Limb{0});
+        add_in_place<Limb>(result.subspan(split), high);
+        return;
+    }
+
+    std::vector<Limb> product(2 * n);
+    std::fill(result.begin(), result.end(), Limb{0});
+    for (std::size_t offset = 0; offset < lhs.size(); offset += n) {
+        const auto chunk = lhs.subspan(offset, std::min(n, lhs.size() - offset));
+        const auto chunk_product = std::span<Limb>(product).first(chunk.size() + n);
+        multiply<Limb>(chunk_product, chunk, rhs);
+        add_in_place<Limb>(result.subspan(offset), chunk_product);
+    }
+}
+
+// Karatsuba multiplication with lhs = a1 * B^h + a0 and rhs = b1 * B^h + b0, where rhs is longer than h:
+// lhs * rhs = z2 * B^2h + ((a0 + a1) * (b0 + b1) - z2 - z0) * B^h + z0, with z0 = a0 * b0 and z2 = a1 * b1.
+template <typename Limb>
+void mul_karatsuba(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    const std::size_t h = (lhs.size() + 1) / 2;
+    const auto a0 = lhs.first(h);
+    const auto a1 = lhs.subspan(h);
+    const auto b0 = rhs.first(h);
+    const auto b1 = rhs.subspan(h);
+
+    std::vector<Limb> scratch(4 * h + 4);
+    const auto a_sum = std::span<Limb>(scratch).first(h + 1);
+    const auto b_sum = std::span<Limb>(scratch).subspan(h + 1, h + 1);
+    const auto middle = std::span<Limb>(scratch).subspan(2 * h + 2);
+
+    std::copy(a0.begin(), a0.end(), a_sum.begin());
+    a_sum[h] = add_in_place<Limb>(a_sum.first(h), a1);
+    std::copy(b0.begin(), b0.end(), b_sum.begin());
+    b_sum[h] = add_in_place<Limb>(b_sum.first(h), b1);
+
+    const auto z0 = result.first(2 * h);
+    const auto z2 = result.subspan(2 * h);
+    parallel_invoke(
+        rhs.size(), [&] { multiply<Limb>(z0, a0, b0); }, [&] { multiply<Limb>(z2, a1, b1); },
+        [&] { multiply<Limb>(middle, a_sum, b_sum); });
+    sub_in_place<Limb>(middle, z0);
+    sub_in_place<Limb>(middle, z2);
+    add_in_place<Limb>(result.subspan(h), trim<Limb>(middle));
+}
+
+// Karatsuba squaring, (a1 * B^h + a0)^2 = z2 * B^2h + ((a0 + a1)^2 - z2 - z0) * B^h + z0.
+template <typename Limb>
+void sqr_karatsuba(std::span<Limb> result, std::span<const Limb> value) {
+    const std::size_t h = (value.size() + 1) / 2;
+    const auto a0 = value.first(h);
+    const auto a1 = value.subspan(h);
+
+    std::vector<Limb> scratch(3 * h + 3);
+    const auto sum = std::span<Limb>(scratch).first(h + 1);
+    const auto middle = std::span<Limb>(scratch).subspan(h + 1);
+
+    std::copy(a0.begin(), a0.end(), sum.begin());
+    sum[h] = add_in_place<Limb>(sum.first(h), a1);
+
+    const auto z0 = result.first(2 * h);
+    const auto z2 = result.subspan(2 * h);
+    parallel_invoke(
+        value.size(), [&] { square<Limb>(z0, a0); }, [&] { square<Limb>(z2, a1); },
+        [&] { square<Limb>(middle, sum); });
+    sub_in_place<Limb>(middle, z0);
+    sub_in_place<Limb>(middle, z2);
+    add_in_place<Limb>(result.subspan(h), trim<Limb>(middle));
+}
+
+// Sign-magnitude number used for the intermediate values of Toom-Cook, which can be negative.
+template <typename Limb>
+struct SignedLimbs {
+    std::vector<Limb> magnitude;
+    bool negative = false;
+
+    SignedLimbs() = default;
+    SignedLimbs(std::span<const Limb> value, bool is_negative = false)
+        : magnitude(value.begin(), value.end()), negative(is_negative) {
+        normalize();
+    }
+
+    void normalize() {
+        while (!magnitude.empty() && magnitude.back() == 0) {
+            magnitude.pop_back();
+        }
+        negative = negative && !magnitude.empty();
+    }
+
+    std::span<const Limb> span() const { return magnitude; }
+
+    friend SignedLimbs operator+(const SignedLimbs& lhs, const SignedLimbs& rhs) { return add(lhs, rhs, false); }
+    friend SignedLimbs operator-(const SignedLimbs& lhs, const SignedLimbs& rhs) { return add(lhs, rhs, true); }
+
+    friend SignedLimbs operator*(const SignedLimbs& lhs, const SignedLimbs& rhs) {
+        SignedLimbs result;
+        result.magnitude.resize(lhs.magnitude.size() + rhs.magnitude.size());
+        if (&lhs == &rhs) {
+            square<Limb>(result.magnitude, lhs.magnitude);
+        } else {
+            multiply<Limb>(result.magnitude, lhs.magnitude, rhs.magnitude);
+        }
+        result.negative = lhs.negative != rhs.negative;
+        result.normalize();
+        return result;
+    }
+
+    SignedLimbs& shift_left_one() {
+        magnitude.push_back(0);
+        lshift<Limb>(magnitude, magnitude, 1);
+        normalize();
+        return *this;
+    }
+
+    // Exact division by 2.
+    SignedLimbs& shift_right_one() {
+        rshift<Limb>(magnitude, magnitude, 1);
+        normalize();
+        return *this;
+    }
+
+    // Exact division by 3.
+    SignedLimbs& divide_by_3() {
+        divrem_1<Limb>(magnitude, magnitude, Limb{3});
+        normalize();
+        return *this;
+    }
+
+private:
+    static SignedLimbs add(const SignedLimbs& lhs, const SignedLimbs& rhs, bool negate_rhs) {
+        const bool rhs_negative = rhs.negative != negate_rhs;
+
+        const auto compare = [](std::span<const Limb> a, std::span<const Limb> b) {
+            if (a.size() != b.size()) {
+                return a.size() <=> b.size();
+            }
+            return cmp<Limb>(a, b);
+        };
+
+        SignedLimbs result;
+        if (lhs.negative == rhs_negative) {
+            const auto& longer = lhs.magnitude.size() >= rhs.magnitude.size() ? lhs : rhs;
+            const auto& shorter = lhs.magnitude.size() >= rhs.magnitude.size() ? rhs : lhs;
+            result.magnitude = longer.magnitude;
+            result.magnitude.push_back(0);
+            add_in_place<Limb>(result.magnitude, shorter.magnitude);
+            result.negative = lhs.negative;
+        } else if (compare(lhs.magnitude, rhs.magnitude) >= 0) {
+            result.magnitude = lhs.magnitude;
+            sub_in_place<Limb>(result.magnitude, rhs.magnitude);
+            result.negative = lhs.negative;
+        } else {
+            result.magnitude = rhs.magnitude;
+            sub_in_place<Limb>(result.magnitude, lhs.magnitude);
+            result.negative = rhs_negative;
+        }
+        result.normalize();
+        return result;
+    }
+};
+
+// Evaluates a0 + a1 * x + a2 * x^2 at the points 1, -1 and -2 for Toom-3.
+template <typename Limb>
+std::array<SignedLimbs<Limb>, 3> toom3_evaluate(std::span<const Limb> a0, std::span<const Limb> a1,
+                                                std::span<const Limb> a2) {
+    const SignedLimbs<Limb> p0(a0);
+    const SignedLimbs<Limb> p1(a1);
+    const SignedLimbs<Limb> p2(a2);
+
+    const auto sum = p0 + p2;
+    auto minus_one = sum - p1;
+    auto minus_two = minus_one + p2;
+    minus_two.shift_left_one();
+    return {sum + p1, minus_one, minus_two - p0};
+}
+
+// Toom-Cook 3-way multiplication, splitting both operands into three parts of k limbs, evaluating at
+// 0, 1, -1, -2 and infinity and interpolating with the sequence by Bodrato.
+template <typename Limb>
+void mul_toom3(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs, bool squaring) {
+    const std::size_t k = (lhs.size() + 2) / 3;
+    const auto a0 = lhs.first(k);
+    const auto a1 = lhs.subspan(k, k);
+    const auto a2 = lhs.subspan(2 * k);
+    const auto b0 = rhs.first(k);
+    const auto b1 = rhs.subspan(k, k);
+    const auto b2 = rhs.subspan(2 * k);
+
+    const auto r_0 = result.first(2 * k);
+    const auto r_inf = result.subspan(4 * k);
+    std::fill(result.begin() + static_cast<std::ptrdiff_t>(2 * k), result.begin() + static_cast<std::ptrdiff_t>(4 * k),
+              Limb{0});
+
+    std::array<SignedLimbs<Limb>, 3> products;
+    if (squaring) {
+        const auto points = toom3_evaluate(a0, a1, a2);
+        parallel_invoke(
+            rhs.size(), [&] { square<Limb>(r_0, a0); }, [&] { square<Limb>(r_inf, a2); },
+            [&] { products[0] = points[0] * points[0]; }, [&] { products[1] = points[1] * points[1]; },
+            [&] { products[2] = points[2] * points[2]; });
+    } else {
+        const auto lhs_points = toom3_evaluate(a0, a1, a2);
+        const auto rhs_points = toom3_evaluate(b0, b1, b2);
+        parallel_invoke(
+            rhs.size(), [&] { multiply<Limb>(r_0, a0, b0); }, [&] { multiply<Limb>(r_inf, a2, b2); },
+            [&] { products[0] = lhs_points[0] * rhs_points[0]; }, [&] { products[1] = lhs_points[1] * rhs_points[1]; },
+            [&] { products[2] = lhs_points[2] * rhs_points[2]; });
+    }
+    const auto& [r_1, r_minus_1, r_minus_2] = products;
+
+    const SignedLimbs<Limb> r0(r_0);
+    const SignedLimbs<Limb> r4(r_inf);
+
+    auto r3 = r_minus_2 - r_1;
+    r3.divide_by_3();
+    auto r1 = r_1 - r_minus_1;
+    r1.shift_right_one();
+    auto r2 = r_minus_1 - r0;
+    r3 = r2 - r3;
+    r3.shift_right_one();
+    auto r4_twice = r4;
+    r3 = r3 + r4_twice.shift_left_one();
+    r2 = r2 + r1 - r4;
+    r1 = r1 - r3;
+
+    add_in_place<Limb>(result.subspan(k), r1.span());
+    add_in_place<Limb>(result.subspan(2 * k), r2.span());
+    add_in_place<Limb>(result.subspan(3 * k), r3.span());
+}
+
+// result = lhs * rhs, result must hold exactly lhs.size() + rhs.size() limbs. The algorithm is picked from the size
+// of the operands.
+template <typename Limb>
+void multiply(std::span<Limb> result, std::span<const Limb> lhs, std::span<const Limb> rhs) {
+    using thresholds = multiplication_thresholds<Limb>;
+
+    if (lhs.size() < rhs.size()) {
+        std::swap(lhs, rhs);
+    }
+
+    if (rhs.size() < thresholds::karatsuba) {
+        mul_basecase(result, lhs, rhs);
+    } else if (rhs.size() >= thresholds::ntt) {
+        if constexpr (std::is_same_v<Limb, uint64_t>) {
+            mul_ntt(result, lhs, rhs);
+        }
+    } else if (2 * rhs.size() <= lhs.size() + 1) {
+        mul_unbalanced(result, lhs, rhs);
+    } else if (rhs.size() >= thresholds::toom3 && rhs.size() > 2 * ((lhs.size() + 2) / 3)) {
+        mul_toom3(result, lhs, rhs, false);
+    } else {
+        mul_karatsuba(result, lhs, rhs);
+    }
+}
+
+// result = value^2, result must hold exactly 2 * value.size() limbs.
+template <typename Limb>
+void square(std::span<Limb> result, std::span<const Limb> value) {
+    using thresholds = multiplication_thresholds<Limb>;
+
+    if (value.size() < thresholds::karatsuba_square) {
+        sqr_basecase(result, value);
+    } else if (value.size() >= thresholds::ntt_square) {
+        if constexpr (std::is_same_v<Limb, uint64_t>) {
+            mul_ntt(result, value, value);
+        }
+    } else if (value.size() >= thresholds::toom3_square) {
+        mul_toom3(result, value, value, true);
+    } else {
+        sqr_karatsuba(result, value);
+    }
+}
+
+} // namespace detail
+} // namespace aba
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "limb.hpp"
+#include "thread_pool.hpp"
+
+namespace aba::detail {
+
+// Arithmetic modulo an odd prime below 2^62 in Montgomery form (R = 2^64) for the number theoretic transform. The
+// prime is c * 2^k + 1 and Generator a primitive root, which gives roots of unity for transforms up to 2^k long.
+template <uint64_t Prime, uint64_t Generator>
+class NttPrime {
+public:
+    static constexpr uint64_t prime = Prime;
+    static constexpr uint32_t max_log_size = static_cast<uint32_t>(std::countr_zero(Prime - 1));
+
+    // Montgomery product, a * b / R mod prime.
+    static constexpr uint64_t mul(uint64_t lhs, uint64_t rhs) {
+        const auto [low, high] = mul_wide(lhs, rhs);
+        return reduce(low, high);
+    }
+
+    static constexpr uint64_t add(uint64_t lhs, uint64_t rhs) {
+        const uint64_t sum = lhs + rhs;
+        return sum >= prime ? sum - prime : sum;
+    }
+
+    static constexpr uint64_t sub(uint64_t lhs, uint64_t rhs) { return lhs >= rhs ? lhs - rhs : lhs + prime - rhs; }
+
+    // Converts from and to Montgomery form.
+    static constexpr uint64_t to_montgomery(uint64_t value) { return mul(value % prime, r_squared); }
+    static constexpr uint64_t from_montgomery(uint64_t value) { return reduce(value, 0); }
+
+    // base^exponent, base and result in Montgomery form.
+    static constexpr uint64_t pow(uint64_t base, uint64_t exponent) {
+        uint64_t result = to_montgomery(1);
+        while (exponent != 0) {
+            if ((exponent & 1) != 0) {
+                result = mul(result, base);
+            }
+            base = mul(base, base);
+            exponent = exponent >> 1;
+        }
+        return result;
+    }
+
+    // In place forward transform (decimation in frequency) of values in normal form, the result is in bit reversed
+    // order.
+    static void forward(std::span<uint64_t> values) {
+        const auto roots = root_table(values.size(), false);
+        for (std::size_t half = values.size() / 2; half >= 1; half /= 2) {
+            const uint64_t* level = roots->data() + half;
+            for (std::size_t start = 0; start < values.size(); start += 2 * half) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    const uint64_t u = values[start + j];
+                    const uint64_t v = values[start + j + half];
+                    values[start + j] = add(u, v);
+                    values[start + j + half] = mul(sub(u, v), level[j]);
+                }
+            }
+        }
+    }
+
+    // In place inverse transform (decimation in time) from bit reversed order. The values are multiplied by scale / R,
+    // which is used to divide by the transform length and to remove the Montgomery factor of the pointwise products.
+    static void inverse(std::span<uint64_t> values, uint64_t scale) {
+        const auto roots = root_table(values.size(), true);
+        for (std::size_t half = 1; half < values.size(); half *= 2) {
+            const uint64_t* level = roots->data() + half;
+            for (std::size_t start = 0; start < values.size(); start += 2 * half) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    const uint64_t u = values[start + j];
+                    const uint64_t v = mul(values[start + j + half], level[j]);
+                    values[start + j] = add(u, v);
+                    values[start + j + half] = sub(u, v);
+                }
+            }
+        }
+        for (auto& value : values) {
+            value = mul(value, scale);
+        }
+    }
+
+    // Scale for inverse() which turns a transform of pointwise Montgomery products into the plain convolution,
+    // R^2 / size mod prime.
+    static uint64_t inverse_scale(std::size_t size) {
+        const uint64_t size_inverse = pow(to_montgomery(size), prime - 2);
+        return mul(size_inverse, r_squared);
+    }
+
+private:
+    // -prime^-1 mod 2^64, from Newton's iteration x = x * (2 - prime * x) which doubles the correct bits each step.
+    static constexpr uint64_t compute_negated_inverse() {
+        uint64_t inverse = prime;
+        for (int i = 0; i < 5; ++i) {
+            inverse *= 2 - prime * inverse;
+        }
+        return uint64_t{0} - inverse;
+    }
+
+    static constexpr uint64_t compute_r_squared() {
+        // 2^128 mod prime, by doubling 2^64 mod prime 64 times.
+        uint64_t value = (~uint64_t{0} % prime) + 1;
+        for (int i = 0; i < 64; ++i) {
+            value = add(value, value);
+        }
+        return value;
+    }
+
+    static constexpr uint64_t negated_inverse = compute_negated_inverse();
+
+    // (high, low) / R mod prime for (high, low) < prime * R.
+    static constexpr uint64_t reduce(uint64_t low, uint64_t high) {
+        const uint64_t m = low * negated_inverse;
+        const auto [product_low, product_high] = mul_wide(m, prime);
+        uint64_t carry = 0;
+        add_carry(low, product_low, carry);
+        const uint64_t result = high + product_high + carry;
+        return result >= prime ? result - prime : result;
+    }
+
+    static constexpr uint64_t r_squared = compute_r_squared();
+
+    using table_t = std::shared_ptr<const std::vector<uint64_t>>;
+
+    // Twiddle factors for transforms of up to size values, in Montgomery form. Entry half + j is the j-th power of the
+    // primitive 2 * half-th root of unity (or its inverse). The tables are shared between calls and only grow.
+    static table_t root_table(std::size_t size, bool inverse) {
+        static std::mutex mutex;
+        static std::array<table_t, 2> tables;
+
+        std::scoped_lock lock(mutex);
+        auto& table = tables[inverse ? 1 : 0];
+        if (!table || table->size() < size) {
+            auto roots = std::make_shared<std::vector<uint64_t>>(std::max<std::size_t>(size, 2));
+            const uint64_t generator = to_montgomery(Generator);
+            for (std::size_t half = 1; half < roots->size(); half *= 2) {
+                uint64_t root = pow(generator, (prime - 1) / (2 * half));
+                if (inverse) {
+                    root = pow(root, prime - 2);
+                }
+                uint64_t power = to_montgomery(1);
+                for (std::size_t j = 0; j < half; ++j) {
+                    (*roots)[half + j] = power;
+                    power = mul(power, root);
+                }
+            }
+            table = std::move(roots);
+        }
+        return table;
+    }
+};
+
+using NttPrime1 = NttPrime<0x3FDC'0000'0000'0001, 3>;
+using NttPrime2 = NttPrime<0x3F18'0000'0000'0001, 10>;
+using NttPrime3 = NttPrime<0x3EC4'0000'0000'0001, 37>;
+
+// Transform of an operand modulo three primes, which can be multiplied pointwise with the transform of another
+// operand as long as the product has at most size() limbs. Keeping it around avoids transforming a reused operand
+// again for every product.
+class NttTransform {
+public:
+    NttTransform() = default;
+
+    // Transforms value with the given transform length, a power of two.
+    NttTransform(std::span<const uint64_t> value, std::size_t size) : m_operand_size(value.size()), m_size(size) {
+        parallel_invoke(
+            value.size(), [&] { transform<NttPrime1>(value, m_values[0]); },
+            [&] { transform<NttPrime2>(value, m_values[1]); }, [&] { transform<NttPrime3>(value, m_values[2]); });
+    }
+
+    // Transform length, the largest product that can be computed.
+    std::size_t size() const { return m_size; }
+
+    std::size_t operand_size() const { return m_operand_size; }
+
+    // Transform length needed for a product of lhs_size and rhs_size limbs.
+    static std::size_t size_for(std::size_t lhs_size, std::size_t rhs_size) {
+        return std::bit_ceil(lhs_size + rhs_size);
+    }
+
+    // result = lhs * rhs where result holds lhs.operand_size() + rhs.operand_size() limbs, which must not exceed the
+    // transform length. Both transforms must have the same length.
+    static void multiply(std::span<uint64_t> result, const NttTransform& lhs, const NttTransform& rhs) {
+        std::array<std::vector<uint64_t>, 3> products;
+        parallel_invoke(
+            std::min(lhs.operand_size(), rhs.operand_size()),
+            [&] { pointwise<NttPrime1>(lhs.m_values[0], rhs.m_values[0], products[0]); },
+            [&] { pointwise<NttPrime2>(lhs.m_values[1], rhs.m_values[1], products[1]); },
+            [&] { pointwise<NttPrime3>(lhs.m_values[2], rhs.m_values[2], products[2]); });
+        combine(result, products);
+    }
+
+private:
+    template <typename Prime>
+    void transform(std::span<const uint64_t> value, std::vector<uint64_t>& values) const {
+        values.assign(m_size, 0);
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            values[i] = value[i] % Prime::prime;
+        }
+        Prime::forward(values);
+    }
+
+    template <typename Prime>
+    static void pointwise(const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs,
+                          std::vector<uint64_t>& product) {
+        product.resize(lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            product[i] = Prime::mul(lhs[i], rhs[i]);
+        }
+        Prime::inverse(product, Prime::inverse_scale(product.size()));
+    }
+
+    // Chinese remainder theorem: recovers each coefficient (below p1 * p2 * p3, about 2^185) from its residues with
+    // Garner's algorithm, x = r1 + p1 * (t2 + p2 * t3), and propagates the carries into the result limbs.
+    static void combine(std::span<uint64_t> result, const std::array<std::vector<uint64_t>, 3>& residues) {
+        constexpr uint64_t p1 = NttPrime1::prime;
+        constexpr uint64_t p2 = NttPrime2::prime;
+        constexpr uint64_t p1_inverse_mod_p2 = NttPrime2::pow(NttPrime2::to_montgomery(p1), p2 - 2);
+        constexpr uint64_t p1_inverse_mod_p3 = NttPrime3::pow(NttPrime3::to_montgomery(p1), NttPrime3::prime - 2);
+        constexpr uint64_t p2_inverse_mod_p3 = NttPrime3::pow(NttPrime3::to_montgomery(p2), NttPrime3::prime - 2);
+        constexpr auto p1_p2 = mul_wide(p1, p2);
+
+        // Running sum of the coefficients not yet written out, three limbs are enough for the carries.
+        std::array<uint64_t, 3> accumulator{};
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            if (i < residues[0].size()) {
+                const uint64_t r1 = residues[0][i];
+                const uint64_t r2 = residues[1][i];
+                const uint64_t r3 = residues[2][i];
+
+                const uint64_t t2 = NttPrime2::mul(NttPrime2::sub(r2, r1 % p2), p1_inverse_mod_p2);
+                const uint64_t t3 = NttPrime3::mul(
+                    NttPrime3::sub(NttPrime3::mul(NttPrime3::sub(r3, r1 % NttPrime3::prime), p1_inverse_mod_p3),
+                                   t2 % NttPrime3::prime),
+                    p2_inverse_mod_p3);
+
+                // x = r1 + p1 * t2 + (p1 * p2) * t3
+                std::array<uint64_t, 3> x{};
+                const auto [low, high] = mul_wide(p1, t2);
+                uint64_t carry = 0;
+                x[0] = add_carry(low, r1, carry);
+                x[1] = high + carry;
+                const auto [low_0, high_0] = mul_wide(p1_p2.first, t3);
+                const auto [low_1, high_1] = mul_wide(p1_p2.second, t3);
+                carry = 0;
+                x[0] = add_carry(x[0], low_0, carry);
+                x[1] = add_carry(x[1], high_0, carry);
+                x[2] = high_1 + carry;
+                carry = 0;
+                x[1] = add_carry(x[1], low_1, carry);
+                x[2] += carry;
+
+                carry = 0;
+                for (std::size_t j = 0; j < accumulator.size(); ++j) {
+                    accumulator[j] = add_carry(accumulator[j], x[j], carry);
+                }
+            }
+
+            result[i] = accumulator[0];
+            accumulator = {accumulator[1], accumulator[2], 0};
+        }
+    }
+
+    std::size_t m_operand_size = 0;
+    std::size_t m_size = 0;
+    std::array<std::vector<uint64_t>, 3> m_values;
+};
+
+// result = lhs * rhs through number theoretic transforms, result must hold lhs.size() + rhs.size() limbs.
+inline void mul_ntt(std::span<uint64_t> result, std::span<const uint64_t> lhs, std::span<const uint64_t> rhs) {
+    const std::size_t size = NttTransform::size_for(lhs.size(), rhs.size());
+    if (lhs.data() == rhs.data() && lhs.size() == rhs.size()) {
+        const NttTransform transform(lhs, size);
+        NttTransform::multiply(result, transform, transform);
+        return;
+    }
+
+    NttTransform lhs_transform;
+    NttTransform rhs_transform;
+    parallel_invoke(
+        rhs.size(), [&] { lhs_transform = NttTransform(lhs, size); }, [&] { rhs_transform = NttTransform(rhs, size); });
+    NttTransform::multiply(result, lhs_transform, rhs_transform);
+}
+
+} // namespace aba::detail
@@ -11,18 +11,17 @@ public:
     constexpr Number(int64_t mantissa, int32_t exponent) : m_mantissa(mantissa), m_exponent(exponent) {}
     constexpr Number(BigInt mantissa, int32_t exponent) : m_mantissa(mantissa), m_exponent(exponent) {}
 
+    // Compares without aligning the mantissas in a BigInt, which could overflow: by sign, then by the magnitudes, see
+    // compare_magnitudes().
     friend constexpr std::strong_ordering operator<=>(const Number& lhs, const Number& rhs) {
-        const auto value = lhs - rhs;
-
-        // TODO Maybe normalize or something.
-
-        if (value.m_mantissa > 0) {
-            return std::strong_ordering::greater;
-        } else if (value.m_mantissa < 0) {
-            return std::strong_ordering::less;
+        const int sign = lhs.m_mantissa.is_negative() ? -1 : (lhs.m_mantissa == 0 ? 0 : 1);
+        const int rhs_sign = rhs.m_mantissa.is_negative() ? -1 : (rhs.m_mantissa == 0 ? 0 : 1);
+        if (sign != rhs_sign || sign == 0) {
+            return sign <=> rhs_sign;
         }
 
-        return std::strong_ordering::equal;
+        const auto order = compare_magnitudes(lhs, rhs);
+        return sign > 0 ? order : 0 <=> order;
     }
 
     friend constexpr bool operator==(const Number& lhs, const Number& rhs) {
@@ -44,14 +43,11 @@ public:
             return Number(lhs.m_mantissa + rhs.m_mantissa, lhs.m_exponent);
         }
 
-        // TODO Check for overflow.
-        if (lhs.m_exponent > rhs.m_exponent) {
-            return Number(lhs.m_mantissa * aba::pow(2, lhs.m_exponent - rhs.m_exponent) + rhs.m_mantissa,
-                          rhs.m_exponent);
-        } else {
-            return Number(rhs.m_mantissa * aba::pow(2, rhs.m_exponent - lhs.m_exponent) + lhs.m_mantissa,
-                          lhs.m_exponent);
-        }
+        const Number& high = lhs.m_exponent > rhs.m_exponent ? lhs : rhs;
+        const Number& low = lhs.m_exponent > rhs.m_exponent ? rhs : lhs;
+        BigInt mantissa = aligned_mantissa(high, low.m_exponent);
+        mantissa += low.m_mantissa;
+        return Number(mantissa, low.m_exponent);
     }
 
     friend constexpr Number operator-(const Number& lhs, const Number& rhs) {
@@ -59,13 +55,13 @@ public:
             return Number(lhs.m_mantissa - rhs.m_mantissa, lhs.m_exponent);
         }
 
-        // TODO Check for overflow.
         if (lhs.m_exponent > rhs.m_exponent) {
-            return Number(lhs.m_mantissa * aba::pow(2, lhs.m_exponent - rhs.m_exponent) - rhs.m_mantissa,
-                          rhs.m_exponent);
+            BigInt mantissa = aligned_mantissa(lhs, rhs.m_exponent);
+            mantissa -= rhs.m_mantissa;
+            return Number(mantissa, rhs.m_exponent);
         } else {
-            return Number(-rhs.m_mantissa * aba::pow(2, rhs.m_exponent - lhs.m_exponent) + lhs.m_mantissa,
-                          lhs.m_exponent);
+            const BigInt mantissa = aligned_mantissa(rhs, lhs.m_exponent);
+            return Number(lhs.m_mantissa - mantissa, lhs.m_exponent);
         }
     }
 
@@ -109,7 +105,66 @@ public:
     // inline std::string to_string() const { return to_string(10); }
 
 private:
+    // Orders the magnitudes by the positions of their leading bits, and only if those tie by the mantissas aligned in
+    // the unsigned type, where the shift is then below n_bits and cannot overflow.
+    static constexpr std::strong_ordering compare_magnitudes(const Number& lhs, const Number& rhs) {
+        const int64_t lhs_top = static_cast<int64_t>(lhs.m_mantissa.bit_length()) + lhs.m_exponent;
+        const int64_t rhs_top = static_cast<int64_t>(rhs.m_mantissa.bit_length()) + rhs.m_exponent;
+        if (lhs_top != rhs_top) {
+            return lhs_top <=> rhs_top;
+        }
+
+        auto magnitude = [](const BigInt& value) { return BigUInt(value.is_negative() ? -value : value); };
+        BigUInt lhs_magnitude = magnitude(lhs.m_mantissa);
+        BigUInt rhs_magnitude = magnitude(rhs.m_mantissa);
+        const int64_t distance = static_cast<int64_t>(lhs.m_exponent) - rhs.m_exponent;
+        if (distance > 0) {
+            lhs_magnitude <<= static_cast<uint32_t>(distance);
+        } else {
+            rhs_magnitude <<= static_cast<uint32_t>(-distance);
+        }
+        return lhs_magnitude <=> rhs_magnitude;
+    }
+
+    // The mantissa of value rescaled to the lower exponent low. The exponents can be up to 2^32 - 1 apart, so the
+    // distance is computed in 64 bits. Throws std::out_of_range if the shifted magnitude does not fit beside the sign
+    // bit.
+    static constexpr BigInt aligned_mantissa(const Number& value, int32_t low) {
+        if (value.m_mantissa == 0) {
+            return BigInt(0);
+        }
+        const auto distance = static_cast<uint64_t>(static_cast<int64_t>(value.m_exponent) - low);
+        if (value.m_mantissa.bit_length() + distance > BigInt::n_bits - 1) {
+            throw std::out_of_range("Exponents too far apart");
+        }
+        return value.m_mantissa << static_cast<uint32_t>(distance);
+    }
+
     BigInt m_mantissa{0};
     int32_t m_exponent;
 };
 } // namespace aba
+
+// Formats the mantissa with the specification of BigInt, followed by the binary exponent as "p" and its decimal
+// digits unless it is 0, so Number(3, -44) is "3p-44" and Number(3, -44) in "{:#x}" is "0x3p-44".
+template <>
+struct fmt::formatter<aba::Number> {
+    aba::detail::IntegerFormatSpecs specs;
+
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& ctx) {
+        return specs.parse(ctx);
+    }
+
+    template <typename FormatContext>
+    auto format(const aba::Number& value, FormatContext& ctx) const {
+        std::array<char, 12> exponent{'p'};
+        const auto end = value.exponent() == aba::BigInt(0)
+                             ? exponent.data()
+                             : value.exponent().to_chars(exponent.data() + 1, exponent.data() + exponent.size()).ptr;
+        const aba::BigInt mantissa = value.mantissa();
+        return specs.write(ctx.out(), mantissa.is_negative(),
+                           mantissa.is_negative() ? aba::BigUInt(-mantissa) : aba::BigUInt(mantissa),
+                           std::string_view(exponent.data(), static_cast<std::size_t>(end - exponent.data())));
+    }
+};
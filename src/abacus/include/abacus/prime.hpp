@@ -0,0 +1,388 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "big_int.hpp"
+#include "big_int_functions.hpp"
+#include "limb.hpp"
+#include "modular.hpp"
+#include "mpn.hpp"
+
+namespace aba {
+
+namespace detail {
+
+// Candidates are trial divided by the odd primes below this bound before any modular exponentiation.
+inline constexpr uint32_t sieve_bound = 1024;
+
+constexpr bool is_small_prime(uint32_t value) {
+    if (value < 2) {
+        return false;
+    }
+    for (uint32_t d = 2; d * d <= value; ++d) {
+        if (value % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline constexpr std::size_t n_small_primes = [] {
+    std::size_t count = 0;
+    for (uint32_t value = 3; value < sieve_bound; value += 2) {
+        count += is_small_prime(value) ? 1 : 0;
+    }
+    return count;
+}();
+
+inline constexpr std::array<uint32_t, n_small_primes> small_primes = [] {
+    std::array<uint32_t, n_small_primes> primes{};
+    std::size_t count = 0;
+    for (uint32_t value = 3; value < sieve_bound; value += 2) {
+        if (is_small_prime(value)) {
+            primes[count++] = value;
+        }
+    }
+    return primes;
+}();
+
+// Runs of consecutive small primes whose product fits a limb, so that one pass of single limb remainders over a value
+// gives its residues modulo all primes of a run.
+template <typename Limb>
+struct PrimeGroup {
+    Limb product = 1;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+template <typename Limb>
+constexpr std::size_t count_prime_groups() {
+    std::size_t count = 0;
+    Limb product = 1;
+    for (const uint32_t prime : small_primes) {
+        if (product > std::numeric_limits<Limb>::max() / prime) {
+            count += 1;
+            product = 1;
+        }
+        product = static_cast<Limb>(product * prime);
+    }
+    return count + 1;
+}
+
+template <typename Limb>
+inline constexpr auto prime_groups = [] {
+    std::array<PrimeGroup<Limb>, count_prime_groups<Limb>()> groups{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n_small_primes; ++i) {
+        if (groups[count].product > std::numeric_limits<Limb>::max() / small_primes[i]) {
+            groups[count].end = i;
+            count += 1;
+            groups[count].begin = i;
+        }
+        groups[count].product = static_cast<Limb>(groups[count].product * small_primes[i]);
+    }
+    groups[count].end = n_small_primes;
+    return groups;
+}();
+
+// value mod small_primes[i] for every i.
+template <typename Limb>
+constexpr std::array<uint32_t, n_small_primes> small_residues(std::span<const Limb> value) {
+    std::array<uint32_t, n_small_primes> residues{};
+    for (const auto& group : prime_groups<Limb>) {
+        const Limb rem = mod_1<Limb>(value, group.product);
+        for (std::size_t i = group.begin; i < group.end; ++i) {
+            residues[i] = static_cast<uint32_t>(rem % small_primes[i]);
+        }
+    }
+    return residues;
+}
+
+// Jacobi symbol (value / modulus) of words, for an odd modulus.
+constexpr int jacobi(uint64_t value, uint64_t modulus) {
+    int result = 1;
+    value %= modulus;
+    while (value != 0) {
+        const int twos = std::countr_zero(value);
+        value >>= twos;
+        // (2 / modulus) = -1 for modulus = 3, 5 mod 8.
+        if ((twos & 1) != 0 && (modulus % 8 == 3 || modulus % 8 == 5)) {
+            result = -result;
+        }
+        // Quadratic reciprocity for odd value and modulus.
+        if (value % 4 == 3 && modulus % 4 == 3) {
+            result = -result;
+        }
+        std::swap(value, modulus);
+        value %= modulus;
+    }
+    return modulus == 1 ? result : 0;
+}
+
+// Jacobi symbol (d / n) for a small odd d and an odd n, through reciprocity and a single limb remainder of n.
+template <std::size_t Limbs, typename Limb>
+constexpr int jacobi(int64_t d, const BigUIntN<Limbs, Limb>& n) {
+    const uint64_t magnitude = d < 0 ? uint64_t{0} - static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+    const uint64_t n_mod_4 = n.limbs()[0] % 4;
+    int result = 1;
+    // (-1 / n) = -1 for n = 3 mod 4.
+    if (d < 0 && n_mod_4 == 3) {
+        result = -result;
+    }
+    if (magnitude % 4 == 3 && n_mod_4 == 3) {
+        result = -result;
+    }
+    return result * jacobi(mod_1<Limb>(n.limbs(), static_cast<Limb>(magnitude)), magnitude);
+}
+
+// Arithmetic modulo an odd n on values in [0, n), safe against the wrap around of the fixed width for n close to
+// 2^n_bits.
+template <std::size_t Limbs, typename Limb>
+struct ResidueRing {
+    using value_t = BigUIntN<Limbs, Limb>;
+
+    constexpr explicit ResidueRing(const value_t& value) : modulus(value), n(value) {}
+
+    constexpr value_t add(const value_t& lhs, const value_t& rhs) const {
+        const value_t sum = lhs + rhs;
+        return sum < lhs || sum >= n ? sum - n : sum;
+    }
+
+    constexpr value_t sub(const value_t& lhs, const value_t& rhs) const {
+        return lhs >= rhs ? lhs - rhs : lhs - rhs + n;
+    }
+
+    // value / 2, (value + n) / 2 for an odd value.
+    constexpr value_t half(const value_t& value) const {
+        return (value.limbs()[0] & 1) == 0 ? value >> 1 : (value >> 1) + (n >> 1) + 1;
+    }
+
+    constexpr value_t from_signed(int64_t value) const {
+        if (value >= 0) {
+            return modulus.reduce(value_t(static_cast<uint64_t>(value)));
+        }
+        const value_t magnitude = modulus.reduce(value_t(uint64_t{0} - static_cast<uint64_t>(value)));
+        return magnitude == 0 ? magnitude : n - magnitude;
+    }
+
+    Modulus<value_t> modulus;
+    value_t n;
+};
+
+// Strong probable prime test to base a (Miller-Rabin) for n - 1 = d 2^s with d odd.
+template <std::size_t Limbs, typename Limb>
+constexpr bool is_strong_probable_prime(const Modulus<BigUIntN<Limbs, Limb>>& modulus, const BigUIntN<Limbs, Limb>& d,
+                                        std::size_t s, uint32_t base) {
+    using value_t = BigUIntN<Limbs, Limb>;
+    const value_t minus_one = modulus.modulus() - 1;
+    value_t x = modulus.powmod(value_t(base), d);
+    if (x == 1 || x == minus_one) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r) {
+        x = modulus.sqrmod(x);
+        if (x == minus_one) {
+            return true;
+        }
+        if (x == 1) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Strong Lucas probable prime test with Selfridge's parameters (Baillie and Wagstaff, "Lucas pseudoprimes", 1980):
+// D is the first of 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and Q = (1 - D) / 4. With n + 1 = k 2^s for an odd k, n
+// passes if U_k = 0 or V_(k 2^r) = 0 for some r < s.
+template <std::size_t Limbs, typename Limb>
+constexpr bool is_strong_lucas_probable_prime(const BigUIntN<Limbs, Limb>& n) {
+    using value_t = BigUIntN<Limbs, Limb>;
+
+    int64_t d = 5;
+    for (int i = 0;; ++i) {
+        const int symbol = jacobi(d, n);
+        if (symbol == -1) {
+            break;
+        }
+        // n > |d| has a factor in common with d.
+        if (symbol == 0) {
+            return false;
+        }
+        // There is no such D for a square, which is only worth checking after a few tries.
+        if (i == 16 && sqrt_rem(n).second == 0) {
+            return false;
+        }
+        d = d > 0 ? -(d + 2) : -d + 2;
+    }
+
+    const ResidueRing<Limbs, Limb> ring(n);
+    const value_t big_d = ring.from_signed(d);
+    const value_t q = ring.from_signed((1 - d) / 4);
+
+    // n + 1 does not wrap around, the largest value 2^n_bits - 1 is divisible by 3.
+    value_t k = n + 1;
+    const std::size_t s = k.countr_zero();
+    k >>= static_cast<uint32_t>(s);
+
+    // Left to right through the bits of k, from U_1 = 1, V_1 = P = 1:
+    // U_2m = U_m V_m, V_2m = V_m^2 - 2 Q^m, U_(m+1) = (U_m + V_m) / 2 and V_(m+1) = (D U_m + V_m) / 2.
+    value_t u = 1;
+    value_t v = 1;
+    value_t q_power = q;
+    constexpr std::size_t bits = limb_bits<Limb>;
+    for (std::size_t bit = k.bit_length() - 1; bit > 0; --bit) {
+        u = ring.modulus.mulmod(u, v);
+        v = ring.sub(ring.modulus.sqrmod(v), ring.add(q_power, q_power));
+        q_power = ring.modulus.sqrmod(q_power);
+        if (((k.limbs()[(bit - 1) / bits] >> ((bit - 1) % bits)) & 1) != 0) {
+            const value_t next_u = ring.half(ring.add(u, v));
+            v = ring.half(ring.add(ring.modulus.mulmod(big_d, u), v));
+            u = next_u;
+            q_power = ring.modulus.mulmod(q_power, q);
+        }
+    }
+
+    if (u == 0 || v == 0) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; ++r) {
+        v = ring.sub(ring.modulus.sqrmod(v), ring.add(q_power, q_power));
+        if (v == 0) {
+            return true;
+        }
+        q_power = ring.modulus.sqrmod(q_power);
+    }
+    return false;
+}
+
+// Primality test of an odd n >= sieve_bound without a factor below it. Below 2^78 the strong probable prime tests to
+// the twelve prime bases up to 37 are a proof (Sorenson and Webster, 2015), above it Baillie-PSW: a strong probable
+// prime test to base 2 and a strong Lucas test, for which no counterexample is known.
+template <std::size_t Limbs, typename Limb>
+constexpr bool is_probable_prime_sieved(const BigUIntN<Limbs, Limb>& n) {
+    using value_t = BigUIntN<Limbs, Limb>;
+    const Modulus<value_t> modulus(n);
+    value_t d = n - 1;
+    const std::size_t s = d.countr_zero();
+    d >>= static_cast<uint32_t>(s);
+
+    if (n.bit_length() <= 78) {
+        if (!is_strong_probable_prime(modulus, d, s, 2)) {
+            return false;
+        }
+        for (std::size_t i = 0; i < 11; ++i) {
+            if (!is_strong_probable_prime(modulus, d, s, small_primes[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return is_strong_probable_prime(modulus, d, s, 2) && is_strong_lucas_probable_prime(n);
+}
+
+} // namespace detail
+
+// True if value is prime, with certainty below 2^78 and by the Baillie-PSW test above. Candidates are trial divided by
+// the primes below 1024 first, a run of them at a time by single limb remainders.
+template <std::size_t Limbs, typename Limb>
+constexpr bool is_probable_prime(const BigUIntN<Limbs, Limb>& value) {
+    if (value < detail::sieve_bound * detail::sieve_bound) {
+        const auto small = static_cast<uint32_t>(value.limbs()[0]);
+        if (small < 2) {
+            return false;
+        }
+        if (small % 2 == 0) {
+            return small == 2;
+        }
+        for (const uint32_t prime : detail::small_primes) {
+            if (prime * prime > small) {
+                break;
+            }
+            if (small % prime == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if ((value.limbs()[0] & 1) == 0) {
+        return false;
+    }
+    for (const uint32_t residue : detail::small_residues<Limb>(value.limbs())) {
+        if (residue == 0) {
+            return false;
+        }
+    }
+    return detail::is_probable_prime_sieved(value);
+}
+
+template <std::size_t Limbs, typename Limb>
+constexpr bool is_probable_prime(const BigIntN<Limbs, Limb>& value) {
+    return !value.is_negative() && is_probable_prime(BigUIntN<Limbs, Limb>(value));
+}
+
+// The smallest prime larger than value, see is_probable_prime(). Throws std::out_of_range if it does not fit. Large
+// candidates are sieved in windows: the residues of the start of a window modulo the small primes give every
+// multiple of those in it without further divisions.
+template <std::size_t Limbs, typename Limb>
+constexpr BigUIntN<Limbs, Limb> next_prime(const BigUIntN<Limbs, Limb>& value) {
+    using value_t = BigUIntN<Limbs, Limb>;
+    constexpr uint32_t window = 4096;
+
+    value_t start = value + 1;
+    if (start == 0) {
+        throw std::out_of_range("No larger prime fits");
+    }
+    while (start < detail::sieve_bound * detail::sieve_bound) {
+        if (is_probable_prime(start)) {
+            return start;
+        }
+        start += 1;
+    }
+
+    while (true) {
+        std::array<bool, window> composite{};
+        const auto residues = detail::small_residues<Limb>(start.limbs());
+        for (std::size_t i = 0; i < detail::n_small_primes; ++i) {
+            const uint32_t prime = detail::small_primes[i];
+            for (uint32_t k = (prime - residues[i]) % prime; k < window; k += prime) {
+                composite[k] = true;
+            }
+        }
+
+        for (uint32_t k = (start.limbs()[0] & 1) == 0 ? 1 : 0; k < window; k += 2) {
+            const value_t candidate = start + k;
+            if (candidate < start) {
+                throw std::out_of_range("No larger prime fits");
+            }
+            if (!composite[k] && detail::is_probable_prime_sieved(candidate)) {
+                return candidate;
+            }
+        }
+
+        start += window;
+        if (start < window) {
+            throw std::out_of_range("No larger prime fits");
+        }
+    }
+}
+
+template <std::size_t Limbs, typename Limb>
+constexpr BigIntN<Limbs, Limb> next_prime(const BigIntN<Limbs, Limb>& value) {
+    if (value.is_negative()) {
+        return BigIntN<Limbs, Limb>(2);
+    }
+    const auto prime = next_prime(BigUIntN<Limbs, Limb>(value));
+    if (BigIntN<Limbs, Limb>(prime).is_negative()) {
+        throw std::out_of_range("No larger prime fits");
+    }
+    return BigIntN<Limbs, Limb>(prime);
+}
+
+} // namespace aba
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "limb.hpp"
+#include "mpn.hpp"
+
+namespace aba::detail {
+
+// Returns the largest power of base that fits in a limb together with its exponent, i.e. the number of digits
+// which can be produced from or accumulated into a single limb.
+template <typename Limb>
+constexpr std::pair<Limb, uint32_t> digit_chunk(uint32_t base) {
+    Limb chunk = static_cast<Limb>(base);
+    uint32_t digits = 1;
+    while (chunk <= std::numeric_limits<Limb>::max() / base) {
+        chunk = static_cast<Limb>(chunk * base);
+        digits += 1;
+    }
+    return {chunk, digits};
+}
+
+// log(2) / log(base) for the bases from 2 to 36 as 0.32 fixed point numbers, rounded down. The logarithm is summed
+// from the series ln(m) = 2 atanh((m - 1) / (m + 1)) in double precision, far more than the 32 bits kept.
+inline constexpr std::array<uint64_t, 37> log_ratios = [] {
+    auto ln = [](double m) {
+        const double z = (m - 1) / (m + 1);
+        double term = z;
+        double sum = 0;
+        for (int k = 1; k < 80; k += 2) {
+            sum += term / k;
+            term *= z * z;
+        }
+        return 2 * sum;
+    };
+    const double ln2 = ln(2.0);
+
+    std::array<uint64_t, 37> ratios{};
+    for (uint32_t base = 2; base <= 36; ++base) {
+        const auto exponent = static_cast<uint32_t>(std::bit_width(base) - 1);
+        const double log2_base = exponent + ln(static_cast<double>(base) / static_cast<double>(1U << exponent)) / ln2;
+        ratios[base] = static_cast<uint64_t>(4294967296.0 / log2_base) - 1;
+    }
+    return ratios;
+}();
+
+// The least and greatest number of digits in a base from 2 to 36 of a value of bits > 0 bits. The values of that bit
+// length have from floor((bits - 1) log(2) / log(base)) + 1 to floor(bits log(2) / log(base)) + 1 digits, where the
+// ratio is within 2^-31 of log_ratios. The two are equal for powers of two.
+constexpr std::pair<uint32_t, uint32_t> digit_bounds(std::size_t bits, uint32_t base) {
+    if (std::has_single_bit(base)) {
+        const auto bits_per_digit = static_cast<std::size_t>(std::countr_zero(base));
+        const auto digits = static_cast<uint32_t>((bits + bits_per_digit - 1) / bits_per_digit);
+        return {digits, digits};
+    }
+
+    const uint64_t ratio = log_ratios[base];
+    return {static_cast<uint32_t>((((bits - 1) * ratio) >> 32) + 1),
+            static_cast<uint32_t>(((bits * (ratio + 2)) >> 32) + 1)};
+}
+
+// Number of digits in a base from 2 to 36 of the value of the given bits, given as its (Limbs) limbs. Where
+// digit_bounds() leaves a choice (rarely more than one) the value is compared to the power of the base, which is
+// built from limb sized powers instead of a full pow().
+template <typename Limb, std::size_t Limbs>
+constexpr uint32_t digit_count(std::span<const Limb> value, std::size_t bits, uint32_t base) {
+    if (bits == 0) {
+        return 1;
+    }
+    auto [digits, max_digits] = digit_bounds(bits, base);
+    if (digits == max_digits) {
+        return digits;
+    }
+
+    // power = base^digits, unless it does not fit.
+    std::array<Limb, Limbs> power{1};
+    std::size_t size = 1;
+    auto multiply = [&power, &size](Limb factor) {
+        const Limb carry = mul_1<Limb>(std::span(power).first(size), std::span(power).first(size), factor);
+        if (carry != 0) {
+            if (size == Limbs) {
+                return false;
+            }
+            power[size++] = carry;
+        }
+        return true;
+    };
+    const auto [chunk, chunk_digits] = digit_chunk<Limb>(base);
+    bool fits = true;
+    for (uint32_t i = 0; i < digits / chunk_digits && fits; ++i) {
+        fits = multiply(chunk);
+    }
+    for (uint32_t i = 0; i < digits % chunk_digits && fits; ++i) {
+        fits = multiply(static_cast<Limb>(base));
+    }
+
+    while (digits < max_digits && fits && cmp<Limb>(value, power) >= 0) {
+        digits += 1;
+        fits = multiply(static_cast<Limb>(base));
+    }
+    return digits;
+}
+
+// Value of a digit character in bases up to 36 (letters in either case), or 0xFF for any other character.
+inline constexpr std::array<uint8_t, 256> digit_values = [] {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (uint8_t i = 0; i < 10; ++i) {
+        values['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 26; ++i) {
+        values['A' + i] = static_cast<uint8_t>(10 + i);
+        values['a' + i] = static_cast<uint8_t>(10 + i);
+    }
+    return values;
+}();
+
+constexpr uint8_t digit_value(char c) { return digit_values[static_cast<uint8_t>(c)]; }
+
+// Eight characters packed into a word, the first one in the lowest byte. Compilers turn this into a single load.
+constexpr uint64_t load_eight(const char* chars) {
+    uint64_t result = 0;
+    for (uint32_t i = 0; i < 8; ++i) {
+        result |= static_cast<uint64_t>(static_cast<uint8_t>(chars[i])) << (8 * i);
+    }
+    return result;
+}
+
+// True if all eight characters of load_eight() are digits below base, for bases up to 10. A byte below '0' wraps
+// around in the subtraction and a byte from '0' + base on reaches 0x80 in the addition, borrows and carries between
+// the bytes only start at a byte which has already failed.
+constexpr bool is_eight_digits(uint64_t chars, uint32_t base) {
+    constexpr uint64_t ones = 0x0101'0101'0101'0101;
+    constexpr uint64_t high_bits = 0x8080'8080'8080'8080;
+    return (((chars - ones * '0') | (chars + ones * (0x80 - '0' - base))) & high_bits) == 0;
+}
+
+// Value of eight digits accepted by is_eight_digits(), by combining neighbouring bytes, then 16-bit and 32-bit lanes.
+// Each step is one multiplication, no lane overflows as base^8 - 1 fits 32 bits.
+constexpr uint32_t eight_digits_value(uint64_t chars, uint32_t base) {
+    constexpr uint64_t ones = 0x0101'0101'0101'0101;
+    const uint64_t base_2 = uint64_t{base} * base;
+    uint64_t value = chars - ones * '0';
+    value = ((value * ((uint64_t{base} << 8) + 1)) >> 8) & 0x00FF'00FF'00FF'00FF;
+    value = ((value * ((base_2 << 16) + 1)) >> 16) & 0x0000'FFFF'0000'FFFF;
+    value = (value * (((base_2 * base_2) << 32) + 1)) >> 32;
+    return static_cast<uint32_t>(value);
+}
+
+// Returns the end of the run of digits in base at the start of [first, last).
+constexpr const char* scan_digits(const char* first, const char* last, uint32_t base) {
+    if (base <= 10) {
+        while (last - first >= 8 && is_eight_digits(load_eight(first), base)) {
+            first += 8;
+        }
+    }
+    while (first != last && digit_value(*first) < base) {
+        ++first;
+    }
+    return first;
+}
+
+// Accumulates the digits at the start of [first, last), at most digit_chunk<Limb>(base).second of them, into value and
+// sets scale to base^(number of digits). Returns the end of the digits read.
+template <typename Limb>
+constexpr const char* accumulate_digits(const char* first, const char* last, uint32_t base, Limb& value, Limb& scale) {
+    const auto max_digits = static_cast<std::ptrdiff_t>(digit_chunk<Limb>(base).second);
+    const char* end = first + std::min(max_digits, last - first);
+
+    value = 0;
+    scale = 1;
+    if (base <= 10) {
+        const auto scale_8 = static_cast<Limb>(uint64_t{base} * base * base * base * base * base * base * base);
+        while (end - first >= 8) {
+            const uint64_t chars = load_eight(first);
+            if (!is_eight_digits(chars, base)) {
+                break;
+            }
+            value = static_cast<Limb>(value * scale_8 + eight_digits_value(chars, base));
+            scale = static_cast<Limb>(scale * scale_8);
+            first += 8;
+        }
+    }
+    for (; first != end; ++first) {
+        const uint8_t digit = digit_value(*first);
+        if (digit >= base) {
+            break;
+        }
+        value = static_cast<Limb>(value * base + digit);
+        scale = static_cast<Limb>(scale * base);
+    }
+    return first;
+}
+
+} // namespace aba::detail
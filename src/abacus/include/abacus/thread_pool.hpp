@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aba {
+
+// When large operations are split into tasks for the shared thread pool. The split never changes a result, only which
+// thread computes which part of it.
+struct ParallelOptions {
+    // Largest number of threads working at once, including the calling ones. 1 keeps everything on the calling thread.
+    std::size_t max_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    // Operand size (in limbs) from which multiplications and divisions are split into tasks.
+    std::size_t threshold = 1024;
+};
+
+namespace detail {
+
+// Workers started on demand that take tasks from a single queue. A thread waiting for the result of a task runs queued
+// tasks in the meantime, so tasks can themselves wait for the tasks they have posted without running out of workers.
+class ThreadPool {
+public:
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stop = true;
+        }
+        m_ready.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ParallelOptions options() const {
+        return {m_max_threads.load(std::memory_order_relaxed), m_threshold.load(std::memory_order_relaxed)};
+    }
+
+    void set_options(const ParallelOptions& options) {
+        m_max_threads.store(std::max<std::size_t>(options.max_threads, 1), std::memory_order_relaxed);
+        m_threshold.store(options.threshold, std::memory_order_relaxed);
+    }
+
+    // Runs task on a worker if fewer than max_threads - 1 tasks are running or queued, and returns its future.
+    // Otherwise returns an invalid future and the caller runs the task itself.
+    std::future<void> try_post(std::function<void()> task) {
+        const std::size_t workers = m_max_threads.load(std::memory_order_relaxed) - 1;
+        std::size_t active = m_active.load(std::memory_order_relaxed);
+        do {
+            if (active >= workers) {
+                return {};
+            }
+        } while (!m_active.compare_exchange_weak(active, active + 1, std::memory_order_relaxed));
+
+        auto packaged = std::make_shared<std::packaged_task<void()>>([this, task = std::move(task)] {
+            struct Release {
+                std::atomic<std::size_t>& active;
+                ~Release() { active.fetch_sub(1, std::memory_order_relaxed); }
+            } release{m_active};
+            task();
+        });
+        auto future = packaged->get_future();
+        {
+            std::scoped_lock lock(m_mutex);
+            while (m_workers.size() < workers) {
+                m_workers.emplace_back([this] { work(); });
+            }
+            m_tasks.emplace_back([packaged] { (*packaged)(); });
+        }
+        m_ready.notify_one();
+        return future;
+    }
+
+    // Waits for a future returned by try_post(), running queued tasks while it is not ready. Rethrows an exception
+    // thrown by the task.
+    void wait(std::future<void>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!run_one()) {
+                // The task is running on another thread, which helps the same way with anything it waits for.
+                future.wait();
+            }
+        }
+        future.get();
+    }
+
+private:
+    bool run_one() {
+        std::function<void()> task;
+        {
+            std::scoped_lock lock(m_mutex);
+            if (m_tasks.empty()) {
+                return false;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_ready.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_tasks.empty()) {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::thread> m_workers;
+    bool m_stop = false;
+
+    std::atomic<std::size_t> m_max_threads = ParallelOptions().max_threads;
+    std::atomic<std::size_t> m_threshold = ParallelOptions().threshold;
+    // Tasks posted and not yet finished.
+    std::atomic<std::size_t> m_active = 0;
+};
+
+inline ThreadPool& thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// True if an operation on operands of the given size (in limbs) is split into tasks.
+inline bool is_parallel(std::size_t size) {
+    const auto options = thread_pool().options();
+    return size >= options.threshold && options.max_threads > 1;
+}
+
+// Runs the tasks, on the shared pool if size reaches the threshold, and returns once all of them are done. The first
+// task always runs on the calling thread, as do the ones the pool has no room for.
+template <typename... Tasks>
+void parallel_invoke(std::size_t size, Tasks&&... tasks) {
+    if (!is_parallel(size)) {
+        (tasks(), ...);
+        return;
+    }
+    auto& pool = thread_pool();
+
+    // Every posted task refers to the callers' tasks, so all of them are waited for before an exception is passed on.
+    std::exception_ptr error;
+    auto guarded = [&error](auto&& call) {
+        try {
+            call();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+    auto run = [&pool, &guarded](auto& first, auto&... rest) {
+        std::array<std::future<void>, sizeof...(rest)> futures{pool.try_post(std::ref(rest))...};
+        guarded(first);
+        std::size_t i = 0;
+        (guarded([&pool, &future = futures[i++], &rest] {
+             if (future.valid()) {
+                 pool.wait(future);
+             } else {
+                 rest();
+             }
+         }),
+         ...);
+    };
+    run(tasks...);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace detail
+
+inline ParallelOptions parallel_options() { return detail::thread_pool().options(); }
+
+// Applies to operations started after the call.
+inline void set_parallel_options(const ParallelOptions& options) { detail::thread_pool().set_options(options); }
+
+} // namespace aba
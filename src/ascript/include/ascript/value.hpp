@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <variant>
 
@@ -76,10 +77,17 @@ public:
     }
 
     std::string to_string() const {
+        std::string result;
+        format_to(std::back_inserter(result));
+        return result;
+    }
+
+    template <typename Out>
+    Out format_to(Out out) const {
         return std::visit(overloaded{
-                              [](int64_t arg) { return fmt::format("{}", arg); },               //
-                              [](double arg) { return fmt::format("{}", arg); },                //
-                              [](const std::string& arg) { return fmt::format("\"{}\"", arg); } //
+                              [&](int64_t arg) { return fmt::format_to(out, "{}", arg); },               //
+                              [&](double arg) { return fmt::format_to(out, "{}", arg); },                //
+                              [&](const std::string& arg) { return fmt::format_to(out, "\"{}\"", arg); } //
                           },
                           m_data);
     }
@@ -111,9 +119,12 @@ inline std::ostream& operator<<(std::ostream& os, const Value& value) {
 namespace fmt {
 template <>
 struct formatter<asc::Value> : formatter<string_view> {
+    // Formats the value into a buffer on the stack instead of a string of its own, only long strings allocate.
     template <typename FormatContext>
-    auto format(const asc::Value& value, FormatContext& ctx) {
-        return formatter<string_view>::format(value.to_string(), ctx);
+    auto format(const asc::Value& value, FormatContext& ctx) const {
+        memory_buffer buffer;
+        value.format_to(std::back_inserter(buffer));
+        return formatter<string_view>::format(string_view(buffer.data(), buffer.size()), ctx);
     }
 };
 
@@ -0,0 +1,64 @@
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/accumulator.hpp>
+
+#include "random.hpp"
+
+namespace {
+template <typename T>
+std::vector<T> random_values(std::size_t count, uint64_t& state) {
+    std::vector<T> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values.push_back(test::random_value<T>(1 + i % T::data_size, state));
+    }
+    values.push_back(~T(0));
+    values.push_back(T(0));
+    return values;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Accumulator sums and dot products agree with the operators", "", aba::BigUInt, aba::BigUInt256,
+                   (aba::BigUIntN<5, uint32_t>), aba::BigInt, aba::BigInt256, (aba::BigIntN<3, uint32_t>)) {
+    uint64_t state = 3;
+    const auto lhs = random_values<TestType>(500, state);
+    const auto rhs = random_values<TestType>(500, state);
+
+    TestType expected_sum(0);
+    TestType expected_dot(0);
+    aba::Accumulator<TestType> accumulator;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        expected_sum += lhs[i];
+        expected_dot += lhs[i] * rhs[i];
+        accumulator += lhs[i];
+        accumulator.add_product(lhs[i], rhs[i]);
+    }
+    REQUIRE(aba::sum(std::span<const TestType>(lhs)) == expected_sum);
+    REQUIRE(aba::dot(std::span<const TestType>(lhs), std::span<const TestType>(rhs)) == expected_dot);
+    REQUIRE(accumulator.value() == expected_sum + expected_dot);
+
+    accumulator.clear();
+    REQUIRE(accumulator.value() == TestType(0));
+    REQUIRE(aba::Accumulator<TestType>(lhs[0]).value() == lhs[0]);
+}
+
+TEST_CASE("Accumulator is constexpr") {
+    constexpr auto value = [] {
+        aba::Accumulator<aba::BigInt> accumulator;
+        accumulator += aba::BigInt(-5);
+        accumulator.add_product(aba::BigInt(-3), aba::BigInt(7));
+        return accumulator.value();
+    }();
+    STATIC_REQUIRE(value == aba::BigInt(-26));
+}
+
+TEST_CASE("Dot product operands must have the same size") {
+    const std::vector<aba::BigUInt> lhs(3);
+    const std::vector<aba::BigUInt> rhs(2);
+    REQUIRE_THROWS_AS(aba::dot(std::span<const aba::BigUInt>(lhs), std::span<const aba::BigUInt>(rhs)),
+                      std::invalid_argument);
+}
@@ -1,9 +1,13 @@
+#include <stdexcept>
 #include <string>
 
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <abacus/big_int.hpp>
 
+#include "random.hpp"
+
 namespace {
 const std::string min_str = "-170141183460469231731687303715884105728";
 const std::string max_str = "170141183460469231731687303715884105727";
@@ -82,6 +86,104 @@ TEST_CASE("Division/Remainder function") {
     REQUIRE((b * result + rem) == a);
 }
 
+TEST_CASE("Long division") {
+    const auto max = aba::BigUInt(aba::BigInt::max());
+
+    auto [result, rem] = aba::BigUInt::division(max, aba::BigUInt(aba::BigInt::from_string("18446744073709551629")));
+    REQUIRE(aba::BigInt(result).to_string() == "9223372036854775801");
+    REQUIRE(aba::BigInt(rem).to_string() == "9223372036854775898");
+
+    std::tie(result, rem) =
+        aba::BigUInt::division(max, aba::BigUInt(aba::BigInt::from_string("340282366920938463463374607431")));
+    REQUIRE(aba::BigInt(result).to_string() == "500000000");
+    REQUIRE(aba::BigInt(rem).to_string() == "384105727");
+
+    std::tie(result, rem) = aba::BigUInt::division(max, aba::BigUInt(18446744069414596665u));
+    REQUIRE(aba::BigInt(result).to_string() == "9223372039002253283");
+    REQUIRE(aba::BigInt(rem).to_string() == "18446691050267004532");
+
+    std::tie(result, rem) =
+        aba::BigUInt::division(max, aba::BigUInt(aba::BigInt::from_string("79228162514264337593543950335")));
+    REQUIRE(aba::BigInt(result).to_string() == "2147483648");
+    REQUIRE(aba::BigInt(rem).to_string() == "2147483647");
+
+    static_assert(aba::BigUInt::division(aba::BigUInt(1'000'000'007), aba::BigUInt(97)).first == 10'309'278);
+    static_assert(aba::BigUInt::division(aba::BigUInt(1'000'000'007), aba::BigUInt(97)).second == 41);
+}
+
+TEMPLATE_TEST_CASE("Long division identity", "", (aba::BigUIntN<4, uint32_t>), aba::BigUInt, aba::BigUInt256,
+                   (aba::BigUIntN<16, uint32_t>), aba::BigUInt1024) {
+    using data_t = typename TestType::data_t;
+    constexpr std::size_t data_size = TestType::data_size;
+
+    // Random operands of every limb length, checked through the identity lhs = rhs * q + r with r < rhs.
+    uint64_t state = 0x9E3779B97F4A7C15;
+    auto next = [&state]() { return static_cast<data_t>(test::next_random(state)); };
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        std::array<data_t, data_size> lhs_data{};
+        std::array<data_t, data_size> rhs_data{};
+        const std::size_t lhs_limbs = 1 + i % data_size;
+        const std::size_t rhs_limbs = 1 + (i / data_size) % lhs_limbs;
+        for (std::size_t j = 0; j < lhs_limbs; ++j) {
+            lhs_data[j] = next();
+        }
+        for (std::size_t j = 0; j < rhs_limbs; ++j) {
+            rhs_data[j] = static_cast<data_t>(next() >> (i % (TestType::n_data_bits - 1)));
+        }
+        rhs_data[0] |= 1;
+
+        const TestType lhs(lhs_data);
+        const TestType rhs(rhs_data);
+        const auto [result, rem] = TestType::division(lhs, rhs);
+        REQUIRE(rem < rhs);
+        REQUIRE(rhs * result + rem == lhs);
+    }
+}
+
+TEST_CASE("Wide integers") {
+    const auto max_256 = "115792089237316195423570985008687907853269984665640564039457584007913129639935";
+    REQUIRE(aba::BigUInt256(aba::BigInt256(-1)).to_string(10) == max_256);
+    REQUIRE(aba::BigUIntN<8, uint32_t>(aba::BigIntN<8, uint32_t>(-1)).to_string(10) == max_256);
+    REQUIRE(aba::BigInt256::min() == -aba::BigInt256::max() - aba::BigInt256(1));
+    REQUIRE((aba::BigUInt256(1) << 255 >> 254).to_string(10) == "2");
+    REQUIRE((aba::BigUInt256(3) << 130).to_string(16) == "C" + std::string(32, '0'));
+
+    aba::BigInt1024 factorial(1);
+    aba::BigIntN<32, uint32_t> factorial_32(1);
+    for (int64_t i = 2; i <= 100; ++i) {
+        factorial = factorial * i;
+        factorial_32 = factorial_32 * i;
+    }
+    const auto expected = "93326215443944152681699238856266700490715968264381621468592963895217599993229915"
+                          "608941463976156518286253697920827223758251185210916864000000000000000000000000";
+    REQUIRE(factorial.to_string() == expected);
+    REQUIRE(factorial_32.to_string() == expected);
+    REQUIRE(aba::BigInt1024::from_string(expected) == factorial);
+    const auto factorial_98 =
+        aba::BigInt1024::from_string("942689044888324774562618574305724247380969376407895166349423877729470707002322"
+                                     "3798882976159207729119823605850588608460429412647567360000000000000000000000");
+    REQUIRE((-factorial / factorial_98).to_string() == "-9900");
+    REQUIRE(factorial % aba::BigInt1024(1'000'000'007) == aba::BigInt1024(437918130));
+
+    static_assert(aba::BigUInt512::pow(aba::BigUInt512(3), 300) / aba::BigUInt512::pow(aba::BigUInt512(3), 299) ==
+                  aba::BigUInt512(3));
+}
+
+TEST_CASE("Wide limb arithmetic") {
+    using limbs = std::pair<uint64_t, uint64_t>;
+
+    REQUIRE(aba::detail::portable_mul_wide(~uint64_t{0}, ~uint64_t{0}) == limbs{1, ~uint64_t{0} - 1});
+    REQUIRE(aba::detail::portable_mul_wide<uint64_t>(0x1234'5678'9ABC'DEF0, 0x0FED'CBA9'8765'4321) ==
+            limbs{0x2236'D88F'E561'8CF0, 0x0121'FA00'AD77'D742});
+
+    REQUIRE(aba::detail::portable_div_wide<uint64_t>(0x0121'FA00'AD77'D742, 0x2236'D88F'E561'8CF0,
+                                                     0x0FED'CBA9'8765'4321) == limbs{0x1234'5678'9ABC'DEF0, 0});
+    REQUIRE(aba::detail::portable_div_wide<uint64_t>(5, 7, 6) == limbs{15372286728091293014u, 3});
+    REQUIRE(aba::detail::portable_div_wide<uint32_t>(41, 0xFFFF'FFFF, 42) ==
+            aba::detail::div_wide<uint32_t>(41, 0xFFFF'FFFF, 42));
+}
+
 TEST_CASE("Tests to_string") {
     REQUIRE(aba::BigInt(0).to_string() == "0");
     REQUIRE(aba::BigInt(-1).to_string() == "-1");
@@ -107,6 +209,42 @@ TEST_CASE("Tests to_string") {
     REQUIRE(aba::BigInt::max().to_string(16) == "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF");
 }
 
+TEST_CASE("To chars") {
+    std::array<char, 64> buffer{};
+    auto result = aba::BigInt::min().to_chars(buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(std::string(buffer.data(), result.ptr) == min_str);
+
+    result = aba::BigInt(1'000'000'000).to_chars(buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(std::string(buffer.data(), result.ptr) == "1000000000");
+
+    result = aba::BigInt(1'000'000'000'000'000'000).to_chars(buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(std::string(buffer.data(), result.ptr) == "1000000000000000000");
+
+    result = aba::BigInt(-35).to_chars(buffer.data(), buffer.data() + buffer.size(), 36);
+    REQUIRE(std::string(buffer.data(), result.ptr) == "-Z");
+
+    result = aba::BigInt(255).to_chars(buffer.data(), buffer.data() + buffer.size(), 2);
+    REQUIRE(std::string(buffer.data(), result.ptr) == "11111111");
+
+    // Exactly fitting and too small output ranges.
+    result = aba::BigInt::max().to_chars(buffer.data(), buffer.data() + max_str.size());
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(std::string(buffer.data(), result.ptr) == max_str);
+
+    result = aba::BigInt::max().to_chars(buffer.data(), buffer.data() + max_str.size() - 1);
+    REQUIRE(result.ec == std::errc::value_too_large);
+
+    result = aba::BigInt(-1).to_chars(buffer.data(), buffer.data() + 1);
+    REQUIRE(result.ec == std::errc::value_too_large);
+
+    static_assert([] {
+        std::array<char, 8> digits{};
+        auto [end, ec] = aba::BigUInt(4095).to_chars(digits.data(), digits.data() + digits.size(), 16);
+        return end - digits.data() == 3 && digits[0] == 'F' && digits[2] == 'F';
+    }());
+}
+
 TEST_CASE("Digits") {
     REQUIRE(aba::BigInt::min().digits(10) == 39);
     REQUIRE(aba::BigInt::max().digits(10) == 39);
@@ -120,6 +258,34 @@ TEST_CASE("Digits") {
             REQUIRE(aba::BigInt(1 * static_cast<uint64_t>(std::pow(base, exp))).digits(base) == exp + 1);
         }
     }
+
+    // Around every power of every base, against the length of the text.
+    for (uint16_t base = 2; base <= 36; ++base) {
+        for (aba::BigUInt256 power = base; power < (aba::BigUInt256(0) - 1) / base; power = power * base) {
+            for (const auto& value : {power - 1, power, power + 1}) {
+                REQUIRE(value.digits(base) == value.to_string(base).size());
+            }
+        }
+        REQUIRE((aba::BigUInt256(0) - 1).digits(base) == (aba::BigUInt256(0) - 1).to_string(base).size());
+    }
+    const auto small = aba::BigUIntN<3, uint32_t>(0) - 1;
+    REQUIRE(small.digits(10) == small.to_string(10).size());
+    STATIC_REQUIRE(aba::BigUInt512(0).digits(7) == 1);
+    STATIC_REQUIRE((aba::BigUInt512(1) << 511).digits(2) == 512);
+}
+
+TEST_CASE("Bit counts") {
+    STATIC_REQUIRE(aba::BigUInt(0).bit_length() == 0);
+    STATIC_REQUIRE(aba::BigUInt(0).countl_zero() == 128);
+    STATIC_REQUIRE(aba::BigUInt(0).countr_zero() == 128);
+    STATIC_REQUIRE((aba::BigUInt(5) << 70).bit_length() == 73);
+    STATIC_REQUIRE((aba::BigUInt(5) << 70).countl_zero() == 55);
+    STATIC_REQUIRE((aba::BigUInt(5) << 70).countr_zero() == 70);
+
+    STATIC_REQUIRE(aba::BigInt(-1).bit_length() == 1);
+    STATIC_REQUIRE(aba::BigInt(-1).countl_zero() == 0);
+    STATIC_REQUIRE(aba::BigInt(-8).countr_zero() == 3);
+    STATIC_REQUIRE(aba::BigInt::min().bit_length() == 128);
 }
 
 TEST_CASE("Addition") {
@@ -212,6 +378,48 @@ TEST_CASE("Multiplication") {
     REQUIRE((aba::BigInt::max() * aba::BigInt(-1)).to_string() == "-" + max_str);
 }
 
+TEMPLATE_TEST_CASE("Compound and fused operations", "", aba::BigInt, aba::BigInt256, (aba::BigIntN<3, uint32_t>)) {
+    const auto a = TestType::from_string("-89644081819840101") << 40;
+    const auto b = TestType::from_string("6165814432430840258246454");
+    const auto c = TestType(-68781054);
+
+    auto value = a;
+    REQUIRE((value += b) == a + b);
+    REQUIRE((value -= c) == a + b - c);
+    REQUIRE((value *= c) == (a + b - c) * c);
+    REQUIRE((value <<= 70) == ((a + b - c) * c) << 70);
+    REQUIRE((value >>= 3) == (((a + b - c) * c) << 70) >> 3);
+
+    // Including the products which wrap around.
+    for (const auto& [lhs, rhs] : {std::pair{b, c}, {c, b}, {a, b}, {b, b}, {c, TestType(0)}}) {
+        value = a;
+        REQUIRE(value.addmul(lhs, rhs) == a + lhs * rhs);
+        REQUIRE(value.submul(lhs, rhs) == a);
+        REQUIRE(value.submul(lhs, rhs) == a - lhs * rhs);
+    }
+
+    value = b;
+    value += value;
+    REQUIRE(value == b + b);
+    value -= value;
+    REQUIRE(value == 0);
+}
+
+TEST_CASE("Fused limb operations") {
+    using data_t = aba::BigUInt::data_t;
+    const auto b = aba::BigUInt(aba::BigInt::from_string("6165814432430840258246454"));
+    auto value = b;
+    REQUIRE(value.addmul(b, 3) == b * 4);
+    REQUIRE(value.submul(b, 3) == b);
+    REQUIRE(value.multiply_add(10, 7) == 0);
+    REQUIRE(value == b * 10 + 7);
+
+    // (2^128 - 1) (2^64 - 1) = (2^64 - 2) 2^128 + 2^128 - 2^64 + 1.
+    value = aba::BigUInt(0) - 1;
+    REQUIRE(value.multiply_add(~data_t{0}, 0) == ~data_t{0} - 1);
+    REQUIRE(value == (aba::BigUInt(0) - 1) * ~data_t{0});
+}
+
 TEST_CASE("Division") {
     REQUIRE((aba::BigInt(50) / aba::BigInt(7)).to_double() == 7.0);
     REQUIRE((aba::BigInt(-50) / aba::BigInt(7)).to_double() == -7.0);
@@ -233,6 +441,11 @@ TEST_CASE("Division") {
             "-3321");
     REQUIRE((aba::BigInt::max() / aba::BigInt::from_string("51224982346756092387132111123232221")).to_string() ==
             "3321");
+
+    REQUIRE_THROWS_AS(aba::BigInt(5) / aba::BigInt(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::BigInt(-5) % aba::BigInt(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::BigUInt(0) / aba::BigUInt(0), std::invalid_argument);
+    REQUIRE_THROWS_AS((aba::BigUIntN<3, uint32_t>(5) % aba::BigUIntN<3, uint32_t>(0)), std::invalid_argument);
 }
 
 TEST_CASE("Comparisons") {
@@ -270,4 +483,101 @@ TEST_CASE("Comparisons") {
 TEST_CASE("From string") {
     REQUIRE(aba::BigInt::from_string("-170141183460469231731687303715884105728") == aba::BigInt::min());
     REQUIRE(aba::BigInt::from_string("170141183460469231731687303715884105727") == aba::BigInt::max());
+    REQUIRE(aba::BigInt::from_string("7FFFFFFFFFFFFFFFffffffffffffffff", 16) == aba::BigInt::max());
+    REQUIRE(aba::BigInt::from_string("-zz", 36) == aba::BigInt(-1295));
+
+    REQUIRE_THROWS_AS(aba::BigInt::from_string(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::BigInt::from_string("12a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::BigInt::from_string("170141183460469231731687303715884105728"), std::out_of_range);
+
+    static_assert(aba::BigInt::from_string("-1234567890123456789012345") == -aba::BigInt(1234567890123) *
+                                                                                  aba::BigInt(1'000'000'000'000) -
+                                                                                  aba::BigInt(456789012345));
+}
+
+TEST_CASE("From chars") {
+    auto parse = [](std::string_view str, aba::BigInt& value, uint32_t base = 10) {
+        return aba::BigInt::from_chars(str.data(), str.data() + str.size(), value, base);
+    };
+
+    aba::BigInt value(42);
+    REQUIRE(parse("", value).ec == std::errc::invalid_argument);
+    REQUIRE(parse("-", value).ec == std::errc::invalid_argument);
+    REQUIRE(parse("+1", value).ec == std::errc::invalid_argument);
+    REQUIRE(parse("12", value, 1).ec == std::errc::invalid_argument);
+    REQUIRE(value == 42);
+
+    const std::string too_large = "-170141183460469231731687303715884105729 ";
+    auto result = parse(too_large, value);
+    REQUIRE(result.ec == std::errc::result_out_of_range);
+    REQUIRE(result.ptr == too_large.data() + too_large.size() - 1);
+    REQUIRE(value == 42);
+
+    const std::string hex = "-DeadBeefCafeBabe1234g";
+    result = parse(hex, value, 16);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(*result.ptr == 'g');
+    REQUIRE(value.to_string(16) == "-DEADBEEFCAFEBABE1234");
+
+    // Every base with a non-digit at every position of the eight character groups.
+    for (uint32_t base = 2; base <= 36; ++base) {
+        for (std::size_t length = 1; length <= 25; ++length) {
+            std::string digits;
+            aba::BigInt expected(0);
+            for (std::size_t i = 0; i < length; ++i) {
+                const auto digit = static_cast<uint32_t>((i * 7 + base) % base);
+                digits.push_back(aba::BigUInt::representation[digit]);
+                expected = expected * aba::BigInt(base) + aba::BigInt(digit);
+            }
+            for (const char stop : {'/', ':', '@', '[', static_cast<char>(0xB9), static_cast<char>('0' + base)}) {
+                if (aba::detail::digit_value(stop) < base) {
+                    continue;
+                }
+                const std::string input = digits + stop + "1";
+                result = parse(input, value, base);
+                REQUIRE(result.ec == std::errc{});
+                REQUIRE(result.ptr == input.data() + length);
+                REQUIRE(value == expected);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Formatting", "", aba::BigInt, aba::BigInt256, (aba::BigIntN<3, uint32_t>), aba::BigInt1024) {
+    using unsigned_t = aba::BigUIntN<TestType::data_size, typename TestType::data_t>;
+
+    // The digits match to_string() in every base, across the limb sized chunks.
+    for (const auto& value : {TestType(0), TestType(1), TestType(-1), TestType::min(), TestType::max(),
+                              TestType::max() / TestType(1000003), TestType(1) << 96}) {
+        REQUIRE(fmt::format("{}", value) == value.to_string());
+        REQUIRE(fmt::format("{:X}", value) == value.to_string(16));
+        REQUIRE(fmt::format("{:b}", value) == value.to_string(2));
+        REQUIRE(fmt::format("{:o}", value) == value.to_string(8));
+        REQUIRE(fmt::format("{}", unsigned_t(value)) == unsigned_t(value).to_string(10));
+    }
+
+    REQUIRE(fmt::format("{:x}", TestType(-0xBEEF)) == "-beef");
+    REQUIRE(fmt::format("{:#x}", TestType(0xBEEF)) == "0xbeef");
+    REQUIRE(fmt::format("{:#X}", TestType(0xBEEF)) == "0XBEEF");
+    REQUIRE(fmt::format("{:#b}", TestType(5)) == "0b101");
+    REQUIRE(fmt::format("{:#o}", TestType(8)) == "010");
+    REQUIRE(fmt::format("{:#o}", TestType(0)) == "0");
+
+    REQUIRE(fmt::format("{:8}", TestType(-42)) == "     -42");
+    REQUIRE(fmt::format("{:<8}", TestType(-42)) == "-42     ");
+    REQUIRE(fmt::format("{:*^8}", TestType(-42)) == "**-42***");
+    REQUIRE(fmt::format("{:08}", TestType(-42)) == "-0000042");
+    REQUIRE(fmt::format("{:#08x}", TestType(42)) == "0x00002a");
+    REQUIRE(fmt::format("{:+}", TestType(42)) == "+42");
+    REQUIRE(fmt::format("{: }", TestType(42)) == " 42");
+    REQUIRE(fmt::format("{:+}", TestType(-42)) == "-42");
+
+    REQUIRE(fmt::format("{:,}", TestType(-1234567)) == "-1,234,567");
+    REQUIRE(fmt::format("{:,}", TestType(123456)) == "123,456");
+    REQUIRE(fmt::format("{:_x}", TestType(0x123456789)) == "1_2345_6789");
+    REQUIRE(fmt::format("{:>12,}", TestType(1234567)) == "   1,234,567");
+    REQUIRE(fmt::format("{:,}", TestType(0)) == "0");
+
+    REQUIRE_THROWS_AS(fmt::format(fmt::runtime("{:q}"), TestType(1)), fmt::format_error);
+    REQUIRE_THROWS_AS(fmt::format(fmt::runtime("{:.3}"), TestType(1)), fmt::format_error);
 }
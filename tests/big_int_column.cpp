@@ -0,0 +1,200 @@
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/big_int_column.hpp>
+
+#include "random.hpp"
+
+namespace {
+// Random values of every length, with zero, one and all ones in between.
+template <typename T>
+std::vector<T> random_values(std::size_t count, uint64_t& state) {
+    std::vector<T> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::array<typename T::data_t, T::data_size> data{};
+        for (std::size_t j = 0; j <= i % T::data_size; ++j) {
+            data[j] = static_cast<typename T::data_t>(test::next_random(state));
+        }
+        if (i % 7 == 3) {
+            data.fill(static_cast<typename T::data_t>(~typename T::data_t{0}));
+        }
+        values.push_back(i % 11 == 5 ? T(i % 2) : T(data));
+    }
+    return values;
+}
+
+int8_t order(std::strong_ordering ordering) { return std::is_lt(ordering) ? -1 : std::is_gt(ordering) ? 1 : 0; }
+} // namespace
+
+TEMPLATE_TEST_CASE("Column batch operations agree with the operators", "", aba::BigUInt, aba::BigInt,
+                   aba::BigUInt256, aba::BigInt256, (aba::BigUIntN<3, uint32_t>), (aba::BigIntN<4, uint32_t>)) {
+    using limb_t = typename TestType::data_t;
+    uint64_t state = 7;
+    // Sizes around the lane counts of the vector kernels.
+    for (const std::size_t size : {0, 1, 3, 8, 9, 37}) {
+        INFO("size " << size);
+        const auto lhs_values = random_values<TestType>(size, state);
+        auto rhs_values = random_values<TestType>(size, state);
+        if (size > 1) {
+            rhs_values[1] = lhs_values[1];
+        }
+        const aba::BigIntColumn<TestType> lhs(lhs_values);
+        const aba::BigIntColumn<TestType> rhs(rhs_values);
+        REQUIRE(lhs.size() == size);
+        REQUIRE(lhs.values() == lhs_values);
+
+        aba::BigIntColumn<TestType> result;
+        aba::add(result, lhs, rhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(result[i] == lhs_values[i] + rhs_values[i]);
+        }
+
+        aba::sub(result, lhs, rhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(result[i] == lhs_values[i] - rhs_values[i]);
+        }
+
+        for (const auto factor : {limb_t{0}, limb_t{1}, static_cast<limb_t>(~limb_t{0}),
+                                  static_cast<limb_t>(test::next_random(state))}) {
+            // The factor is an unsigned limb also for signed values.
+            std::array<limb_t, TestType::data_size> factor_limbs{};
+            factor_limbs[0] = factor;
+            aba::multiply(result, lhs, factor);
+            for (std::size_t i = 0; i < size; ++i) {
+                REQUIRE(result[i] == lhs_values[i] * TestType(factor_limbs));
+            }
+        }
+
+        std::vector<int8_t> orders(size);
+        aba::compare(std::span(orders), lhs, rhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(orders[i] == order(lhs_values[i] <=> rhs_values[i]));
+        }
+
+        constexpr auto bits = static_cast<uint32_t>(TestType::n_bits);
+        const uint32_t limb_bits = std::numeric_limits<limb_t>::digits;
+        for (const uint32_t shift : {0U, 1U, limb_bits - 1, limb_bits, limb_bits + 5, bits - 1, bits, bits + 3}) {
+            INFO("shift " << shift);
+            aba::shift_left(result, lhs, shift);
+            for (std::size_t i = 0; i < size; ++i) {
+                REQUIRE(result[i] == lhs_values[i] << shift);
+            }
+            aba::shift_right(result, lhs, shift);
+            for (std::size_t i = 0; i < size; ++i) {
+                REQUIRE(result[i] == lhs_values[i] >> shift);
+            }
+        }
+
+        // In place, over either operand.
+        auto column = lhs;
+        aba::add(column, column, rhs);
+        aba::sub(column, lhs, column);
+        aba::shift_left(column, column, limb_bits + 3);
+        aba::shift_right(column, column, 2);
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(column[i] == (TestType(0) - rhs_values[i]) << (limb_bits + 3) >> 2);
+        }
+    }
+}
+
+TEST_CASE("Column values can be read and written one at a time") {
+    aba::BigIntColumn<aba::BigInt> column(3);
+    REQUIRE(column.size() == 3);
+    REQUIRE(column[2] == aba::BigInt(0));
+
+    column.set(1, aba::BigInt(-5));
+    column.push_back(aba::BigInt(7));
+    REQUIRE(column.values() == std::vector<aba::BigInt>{0, -5, 0, 7});
+    REQUIRE(column.limbs(0)[1] == ~uint64_t{0} - 4);
+    REQUIRE(column.limbs(1)[1] == ~uint64_t{0});
+
+    aba::BigIntColumn<aba::BigInt> other(2);
+    REQUIRE_THROWS_AS(aba::add(column, column, other), std::invalid_argument);
+    std::vector<int8_t> orders(3);
+    REQUIRE_THROWS_AS(aba::compare(std::span(orders), column, column), std::invalid_argument);
+
+    column.clear();
+    REQUIRE(column.empty());
+}
+
+TEST_CASE("Column kernel variants") {
+    namespace columns = aba::detail::columns;
+
+    STATIC_REQUIRE(aba::simd_kernels_from_string("avx512") == aba::SimdKernels::avx512);
+    STATIC_REQUIRE(!aba::simd_kernels_from_string("sse"));
+    REQUIRE(aba::is_supported(aba::simd_kernels(), aba::cpu_features()));
+
+    constexpr std::size_t limbs = 5;
+    const aba::CpuFeatures features = aba::cpu_features();
+    uint64_t state = 9;
+    for (const auto kernels : {aba::SimdKernels::scalar, aba::SimdKernels::avx2, aba::SimdKernels::avx512}) {
+        if (!aba::is_supported(kernels, features)) {
+            continue;
+        }
+        INFO(aba::to_string(kernels));
+        const auto& table = columns::kernel_table(kernels);
+        for (const std::size_t size : {0, 5, 8, 21, 64}) {
+            std::array<std::vector<uint64_t>, limbs> lhs;
+            std::array<std::vector<uint64_t>, limbs> rhs;
+            std::array<std::vector<uint64_t>, limbs> expected;
+            std::array<std::vector<uint64_t>, limbs> result;
+            std::array<const uint64_t*, limbs> lhs_planes{};
+            std::array<const uint64_t*, limbs> rhs_planes{};
+            std::array<uint64_t*, limbs> expected_planes{};
+            std::array<uint64_t*, limbs> result_planes{};
+            for (std::size_t j = 0; j < limbs; ++j) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    // Runs of all ones carry through every limb.
+                    lhs[j].push_back(i % 4 == 1 ? ~uint64_t{0} : test::next_random(state));
+                    rhs[j].push_back(i % 4 == 1 ? 1 : i % 4 == 2 ? lhs[j][i] : test::next_random(state));
+                }
+                expected[j].resize(size);
+                result[j].resize(size);
+                lhs_planes[j] = lhs[j].data();
+                rhs_planes[j] = rhs[j].data();
+                expected_planes[j] = expected[j].data();
+                result_planes[j] = result[j].data();
+            }
+
+            table.add(result_planes.data(), lhs_planes.data(), rhs_planes.data(), limbs, 0, size);
+            columns::scalar::add<uint64_t>(expected_planes.data(), lhs_planes.data(), rhs_planes.data(), limbs, 0,
+                                           size);
+            REQUIRE(result == expected);
+
+            table.sub(result_planes.data(), lhs_planes.data(), rhs_planes.data(), limbs, 0, size);
+            columns::scalar::sub<uint64_t>(expected_planes.data(), lhs_planes.data(), rhs_planes.data(), limbs, 0,
+                                           size);
+            REQUIRE(result == expected);
+
+            for (const uint64_t factor : {~uint64_t{0}, test::next_random(state)}) {
+                table.mul_1(result_planes.data(), lhs_planes.data(), limbs, factor, 0, size);
+                columns::scalar::mul_1<uint64_t>(expected_planes.data(), lhs_planes.data(), limbs, factor, 0, size);
+                REQUIRE(result == expected);
+            }
+
+            for (const bool is_signed : {false, true}) {
+                std::vector<int8_t> orders(size);
+                std::vector<int8_t> expected_orders(size);
+                table.compare(orders.data(), lhs_planes.data(), rhs_planes.data(), limbs, is_signed, 0, size);
+                columns::scalar::compare<uint64_t>(expected_orders.data(), lhs_planes.data(), rhs_planes.data(),
+                                                   limbs, is_signed, 0, size);
+                REQUIRE(orders == expected_orders);
+            }
+
+            for (const uint32_t shift : {0U, 13U, 64U, 130U, 319U, 320U}) {
+                table.lshift(result_planes.data(), lhs_planes.data(), limbs, shift, 0, size);
+                columns::scalar::lshift<uint64_t>(expected_planes.data(), lhs_planes.data(), limbs, shift, 0, size);
+                REQUIRE(result == expected);
+                table.rshift(result_planes.data(), lhs_planes.data(), limbs, shift, 0, size);
+                columns::scalar::rshift<uint64_t>(expected_planes.data(), lhs_planes.data(), limbs, shift, 0, size);
+                REQUIRE(result == expected);
+            }
+        }
+    }
+}
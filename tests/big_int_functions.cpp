@@ -1,7 +1,37 @@
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <abacus/big_int_functions.hpp>
 
+#include "random.hpp"
+
+namespace {
+// A value of the given number of hexadecimal digits.
+template <typename T>
+T random_value(std::size_t digits, uint64_t& state) {
+    std::string text;
+    for (std::size_t i = 0; i < digits; ++i) {
+        text.push_back("0123456789ABCDEF"[(test::next_random(state) >> 33) % 16]);
+    }
+    T value(0);
+    T::from_chars(text.data(), text.data() + text.size(), value, 16);
+    return value;
+}
+
+template <typename T>
+T euclid_gcd(T lhs, T rhs) {
+    while (rhs != T(0)) {
+        lhs = lhs % rhs;
+        std::swap(lhs, rhs);
+    }
+    return lhs;
+}
+} // namespace
+
 TEST_CASE("Sqrt") {
     REQUIRE(aba::sqrt(aba::BigInt(0)).to_string() == "0");
     REQUIRE(aba::sqrt(aba::BigInt(1)).to_string() == "1");
@@ -23,3 +53,166 @@ TEST_CASE("Root") {
 
     REQUIRE(aba::root(aba::BigInt::from_string("170141183460469231731687303715884105727"), 11).to_string() == "2989");
 }
+
+TEST_CASE("Pow") {
+    REQUIRE(aba::BigInt::pow(aba::BigInt(-3), 5) == -243);
+    REQUIRE(aba::BigInt::pow(aba::BigInt(-3), 4) == 81);
+    REQUIRE(aba::BigUInt::pow(aba::BigUInt(3), 80).to_string(10) == "147808829414345923316083210206383297601");
+    REQUIRE(aba::BigUInt::pow(aba::BigUInt(2), 128) == 0);
+    REQUIRE(aba::Integer::pow(aba::Integer(7), 0) == 1);
+}
+
+TEST_CASE("Root with remainder") {
+    // (root + 1)^n fits 512 bits for every n.
+    const auto value = aba::BigInt512::from_string("170141183460469231731687303715884105727");
+    for (const int32_t n : {1, 2, 3, 5, 11, 126, 127, 200}) {
+        const auto [root, remainder] = aba::root_rem(value, n);
+        REQUIRE(aba::BigInt512::pow(root, static_cast<uint32_t>(n)) + remainder == value);
+        REQUIRE(aba::BigInt512::pow(root + 1, static_cast<uint32_t>(n)) > value);
+    }
+
+    REQUIRE(aba::root_rem(aba::BigUInt(1000), 3) == std::pair(aba::BigUInt(10), aba::BigUInt(0)));
+    REQUIRE(aba::root_rem(aba::BigUInt(999), 3) == std::pair(aba::BigUInt(9), aba::BigUInt(270)));
+    REQUIRE_THROWS_AS(aba::root(aba::BigInt(8), 0), std::invalid_argument);
+}
+
+TEST_CASE("Integer sqrt") {
+    // Large enough for the recursive square root, with odd and even bit lengths.
+    auto value = aba::Integer::from_string("3");
+    for (int i = 0; i < 40; ++i) {
+        value = value * aba::Integer(1000000007) + aba::Integer(i);
+        const auto [root, remainder] = aba::sqrt_rem(value);
+        REQUIRE(root * root + remainder == value);
+        REQUIRE(remainder <= root * aba::Integer(2));
+
+        REQUIRE(aba::sqrt(root * root) == root);
+        REQUIRE(aba::sqrt(root * root - aba::Integer(1)) == root - aba::Integer(1));
+    }
+}
+
+TEST_CASE("Perfect powers") {
+    REQUIRE(aba::is_perfect_power(aba::BigInt(0)));
+    REQUIRE(aba::is_perfect_power(aba::BigInt(1)));
+    REQUIRE(!aba::is_perfect_power(aba::BigInt(2)));
+    REQUIRE(aba::is_perfect_power(aba::BigInt(32)));
+    REQUIRE(!aba::is_perfect_power(aba::BigInt(72)));
+    REQUIRE(aba::is_perfect_power(aba::BigUInt::pow(aba::BigUInt(12345), 7)));
+    REQUIRE(!aba::is_perfect_power(aba::BigUInt::pow(aba::BigUInt(12345), 7) + 1));
+    REQUIRE(aba::is_perfect_power(aba::Integer::pow(aba::Integer(3), 1000)));
+    REQUIRE(!aba::is_perfect_power((aba::Integer(1) << 521) - aba::Integer(1)));
+}
+
+TEMPLATE_TEST_CASE("Gcd", "", aba::BigInt, aba::BigUInt256, (aba::BigUIntN<4, uint32_t>), aba::Integer) {
+    uint64_t state = 29;
+    const std::size_t max_digits = std::is_same_v<TestType, aba::Integer> ? 100 : 31;
+    for (std::size_t digits = 1; digits <= max_digits; digits += 3) {
+        for (int i = 0; i < 10; ++i) {
+            const auto a = random_value<TestType>(digits, state);
+            const auto b = random_value<TestType>(digits / (i % 3 + 1) + 1, state);
+            const auto factor = random_value<TestType>(i % 4 + 1, state);
+            const auto expected = euclid_gcd(a, b);
+            REQUIRE(aba::gcd(a, b) == expected);
+            REQUIRE(aba::gcd(b, a) == expected);
+            if ((a.bit_length() + factor.bit_length()) / 4 < max_digits) {
+                REQUIRE(aba::gcd(a * factor, b * factor) == euclid_gcd(a * factor, b * factor));
+            }
+        }
+    }
+    REQUIRE(aba::gcd(TestType(0), TestType(0)) == TestType(0));
+    REQUIRE(aba::gcd(TestType(0), TestType(12)) == TestType(12));
+    REQUIRE(aba::gcd(TestType(12), TestType(12)) == TestType(12));
+    const auto full_word = (TestType(1) << 64) - TestType(2);
+    REQUIRE(aba::gcd(full_word, full_word - TestType(2)) == TestType(2));
+    REQUIRE(aba::gcd(full_word, (TestType(1) << 63) - TestType(1)) == (TestType(1) << 63) - TestType(1));
+    REQUIRE(aba::lcm(TestType(12), TestType(18)) == TestType(36));
+    REQUIRE(aba::lcm(TestType(0), TestType(18)) == TestType(0));
+}
+
+TEST_CASE("Signed gcd") {
+    REQUIRE(aba::gcd(aba::BigInt(-12), aba::BigInt(18)) == 6);
+    REQUIRE(aba::gcd(aba::Integer(-12), aba::Integer(-18)) == aba::Integer(6));
+    REQUIRE(aba::gcd(aba::BigInt::min(), aba::BigInt(6)) == 2);
+    REQUIRE(aba::lcm(aba::BigInt(-4), aba::BigInt(6)) == 12);
+}
+
+TEMPLATE_TEST_CASE("Extended gcd and inverse", "", aba::BigInt, aba::BigInt256, aba::Integer) {
+    uint64_t state = 31;
+    for (std::size_t digits = 1; digits <= 31; digits += 2) {
+        for (int i = 0; i < 10; ++i) {
+            const auto a = random_value<TestType>(digits, state) * TestType(i % 2 == 0 ? 1 : -1);
+            const auto b = random_value<TestType>(digits / (i % 3 + 1) + 1, state) * TestType(i % 3 == 0 ? -1 : 1);
+            const auto [g, s, t] = aba::xgcd(a, b);
+            REQUIRE(g == aba::gcd(a, b));
+            REQUIRE(s * a + t * b == g);
+            if (a != TestType(0) && b != TestType(0)) {
+                REQUIRE(aba::detail::magnitude(s) <= aba::detail::magnitude(b / g));
+                REQUIRE(aba::detail::magnitude(t) <= aba::detail::magnitude(a / g));
+            }
+
+            const auto modulus = b < TestType(0) ? -b : b;
+            if (g == TestType(1) && modulus > TestType(1)) {
+                const auto inverse = aba::modinv(a, modulus);
+                REQUIRE(inverse >= TestType(0));
+                REQUIRE(inverse < modulus);
+                // In Integer, the product may not fit the fixed width types.
+                auto integer = [](const TestType& value) { return aba::Integer::from_string(value.to_string()); };
+                const auto product = integer(a) * integer(inverse) % integer(modulus);
+                REQUIRE((product == aba::Integer(1) || product == aba::Integer(1) - integer(modulus)));
+            }
+        }
+    }
+
+    REQUIRE(aba::modinv(TestType(3), TestType(7)) == TestType(5));
+    REQUIRE(aba::modinv(TestType(-3), TestType(7)) == TestType(2));
+    REQUIRE(aba::modinv(TestType(5), TestType(1)) == TestType(0));
+    REQUIRE_THROWS_AS(aba::modinv(TestType(6), TestType(9)), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::modinv(TestType(6), TestType(0)), std::invalid_argument);
+}
+
+TEST_CASE("Unsigned extended gcd") {
+    // The cofactors of BigUIntN are two's complement.
+    const auto [g, s, t] = aba::xgcd(aba::BigUInt(240), aba::BigUInt(46));
+    REQUIRE(g == 2);
+    REQUIRE(s * 240 + t * 46 == 2);
+    REQUIRE(aba::modinv(aba::BigUInt(46), aba::BigUInt(239)) * 46 % 239 == 1);
+}
+
+TEST_CASE("Half gcd of long Integers") {
+    // Long enough for a few levels of the half gcd recursion, with a large common factor.
+    uint64_t state = 37;
+    for (const std::size_t digits : {1500, 4000, 9000}) {
+        const auto factor = random_value<aba::Integer>(digits / 3, state);
+        const auto a = random_value<aba::Integer>(digits, state) * factor;
+        const auto b = random_value<aba::Integer>(digits - 7, state) * factor;
+        const auto expected = euclid_gcd(a, b);
+        REQUIRE(aba::gcd(a, b) == expected);
+
+        const auto [g, s, t] = aba::xgcd(a, b);
+        REQUIRE(g == expected);
+        REQUIRE(s * a + t * b == g);
+    }
+}
+
+TEST_CASE("Half gcd of unbalanced Integers") {
+    // Operands of very different lengths, the longer one with at least 4096 bits.
+    uint64_t state = 41;
+    const std::pair<std::size_t, std::size_t> limbs[] = {{64, 1}, {64, 10}, {64, 32}, {70, 34}, {100, 50}, {200, 120}};
+    for (const auto& [long_limbs, short_limbs] : limbs) {
+        const auto factor = random_value<aba::Integer>(4 * short_limbs, state);
+        const auto a = random_value<aba::Integer>(16 * long_limbs - 4 * short_limbs, state) * factor;
+        const auto b = random_value<aba::Integer>(12 * short_limbs, state) * factor;
+        const auto expected = euclid_gcd(a, b);
+        REQUIRE(aba::gcd(a, b) == expected);
+        REQUIRE(aba::gcd(b, a) == expected);
+
+        const auto [g, s, t] = aba::xgcd(a, b);
+        REQUIRE(g == expected);
+        REQUIRE(s * a + t * b == g);
+    }
+
+    const auto modulus = (aba::Integer(1) << 4400) - aba::Integer(1);
+    const auto inverse = aba::modinv(aba::Integer(1) << 10, modulus);
+    REQUIRE(inverse == aba::Integer(1) << 4390);
+    REQUIRE(aba::modinv(aba::Integer(3), aba::Integer(1) << 4400) * aba::Integer(3) % (aba::Integer(1) << 4400) ==
+            aba::Integer(1));
+}
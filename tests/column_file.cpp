@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/column_file.hpp>
+
+#include "random.hpp"
+
+namespace {
+template <typename T>
+std::vector<T> random_values(std::size_t count, uint64_t state) {
+    std::vector<T> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values.push_back(test::random_value<T>(T::data_size, state));
+    }
+    return values;
+}
+
+std::filesystem::path temporary_path(const std::string& name) {
+    return std::filesystem::temp_directory_path() / ("abacus_column_file_" + name);
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Column files map the values they were written with", "", aba::BigUInt, aba::BigInt,
+                   aba::BigUInt256, (aba::BigIntN<3, uint32_t>)) {
+    const auto path = temporary_path("values");
+    // Sizes around the chunks of the writer.
+    for (const std::size_t size : {0, 1, 5, 4096, 5000}) {
+        INFO("size " << size);
+        const auto values = random_values<TestType>(size, size + 1);
+
+        {
+            aba::ColumnFileWriter<TestType> writer(path);
+            writer.write(values);
+            REQUIRE(writer.size() == size);
+        }
+        {
+            const aba::MappedColumnFile<TestType> file(path);
+            REQUIRE(file.layout() == aba::ColumnLayout::rows);
+            REQUIRE(file.size() == size);
+            const auto mapped = file.values();
+            REQUIRE(std::vector<TestType>(mapped.begin(), mapped.end()) == values);
+            REQUIRE(reinterpret_cast<uintptr_t>(mapped.data()) % aba::column_file_alignment == 0);
+            REQUIRE_THROWS_AS(file.column(), std::runtime_error);
+        }
+
+        {
+            aba::ColumnFileWriter<TestType> writer(path, aba::ColumnLayout::columns, size);
+            for (const auto& value : values) {
+                writer.write(value);
+            }
+            writer.close();
+        }
+        const aba::MappedColumnFile<TestType> file(path);
+        REQUIRE(file.layout() == aba::ColumnLayout::columns);
+        const auto column = file.column();
+        REQUIRE(column.values() == values);
+        for (std::size_t j = 0; j < TestType::data_size; ++j) {
+            REQUIRE(reinterpret_cast<uintptr_t>(column.limbs(j).data()) % aba::column_file_alignment == 0);
+        }
+        if (size > 0) {
+            REQUIRE(file[size - 1] == values.back());
+        }
+
+        // The planes go straight to the batch operations.
+        aba::BigIntColumn<TestType> sum;
+        aba::add(sum, column, column);
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(sum[i] == values[i] + values[i]);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Column files are checked when written and mapped") {
+    const auto path = temporary_path("checks");
+
+    REQUIRE_THROWS_AS(aba::ColumnFileWriter<aba::BigInt>(path, aba::ColumnLayout::columns), std::invalid_argument);
+    {
+        aba::ColumnFileWriter<aba::BigInt> writer(path, aba::ColumnLayout::columns, 2);
+        writer.write(aba::BigInt(1));
+        REQUIRE_THROWS_AS(writer.close(), std::runtime_error);
+    }
+    {
+        aba::ColumnFileWriter<aba::BigInt> writer(path, aba::ColumnLayout::rows, 1);
+        writer.write(aba::BigInt(-1));
+        REQUIRE_THROWS_AS(writer.write(aba::BigInt(2)), std::out_of_range);
+    }
+
+    REQUIRE(aba::MappedColumnFile<aba::BigInt>(path)[0] == aba::BigInt(-1));
+    REQUIRE_THROWS_AS(aba::MappedColumnFile<aba::BigUInt>(path), std::runtime_error);
+    REQUIRE_THROWS_AS(aba::MappedColumnFile<aba::BigInt256>(path), std::runtime_error);
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    REQUIRE_THROWS_AS(aba::MappedColumnFile<aba::BigInt>(path), std::runtime_error);
+
+    std::ofstream(path) << "1234567890";
+    REQUIRE_THROWS_AS(aba::MappedColumnFile<aba::BigInt>(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(aba::MappedColumnFile<aba::BigInt>(path), std::system_error);
+}
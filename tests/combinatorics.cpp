@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/combinatorics.hpp>
+
+namespace {
+aba::Integer naive_factorial(uint32_t n) {
+    aba::Integer result(1);
+    for (uint32_t i = 2; i <= n; ++i) {
+        result *= aba::Integer(i);
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("Factorial") {
+    for (uint32_t n = 0; n < 100; ++n) {
+        INFO(n);
+        REQUIRE(aba::factorial(n) == naive_factorial(n));
+    }
+    REQUIRE(aba::factorial(20).to_string() == "2432902008176640000");
+    REQUIRE(aba::factorial(25).to_string() == "15511210043330985984000000");
+
+    // Large enough for threads and the subquadratic multiplications.
+    for (const uint32_t n : {1000U, 30'000U}) {
+        INFO(n);
+        REQUIRE(aba::factorial(n) == naive_factorial(n));
+    }
+}
+
+TEST_CASE("Binomial") {
+    std::vector<aba::Integer> row = {aba::Integer(1)};
+    for (uint64_t n = 0; n < 80; ++n) {
+        for (uint64_t k = 0; k <= n; ++k) {
+            INFO(n << " " << k);
+            REQUIRE(aba::binomial(n, k) == row[k]);
+        }
+        REQUIRE(aba::binomial(n, n + 1) == 0);
+
+        std::vector<aba::Integer> next(row.size() + 1, aba::Integer(1));
+        for (std::size_t k = 1; k < row.size(); ++k) {
+            next[k] = row[k - 1] + row[k];
+        }
+        row = std::move(next);
+    }
+
+    REQUIRE(aba::binomial(2000, 1000) * aba::factorial(1000) * aba::factorial(1000) == aba::factorial(2000));
+    REQUIRE(aba::binomial(100'000, 3).to_string() == "166661666700000");
+
+    // Pascal's rule for long values, and factors that use the full word.
+    for (const auto& [n, k] : {std::pair<uint64_t, uint64_t>{60'000, 30'000}, {50'001, 1'000}}) {
+        REQUIRE(aba::binomial(n, k) == aba::binomial(n - 1, k - 1) + aba::binomial(n - 1, k));
+    }
+    const uint64_t large = ~uint64_t{0};
+    const auto word = [](uint64_t value) { return aba::Integer::from_limbs(std::span<const uint64_t>(&value, 1)); };
+    REQUIRE(aba::binomial(large, 1) == word(large));
+    REQUIRE(aba::binomial(large, large - 2) == word(large) * word(large - 1) / 2);
+}
+
+TEST_CASE("Primorial") {
+    REQUIRE(aba::primorial(0) == 1);
+    REQUIRE(aba::primorial(1) == 1);
+    REQUIRE(aba::primorial(2) == 2);
+    REQUIRE(aba::primorial(30) == 6469693230);
+
+    const uint32_t n = 200'000;
+    aba::Integer expected(1);
+    for (uint32_t value = 2; value <= n; ++value) {
+        bool prime = true;
+        for (uint32_t d = 2; prime && d * d <= value; ++d) {
+            prime = value % d != 0;
+        }
+        if (prime) {
+            expected *= aba::Integer(value);
+        }
+    }
+    REQUIRE(aba::primorial(n) == expected);
+}
+
+TEST_CASE("Product trees on several threads") {
+    std::vector<uint64_t> words(5000);
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        words[i] = ~uint64_t{0} - 2 * i;
+    }
+
+    const auto options = aba::parallel_options();
+    aba::set_parallel_options({1, options.threshold});
+    const auto expected = aba::detail::product_tree(words);
+    for (const std::size_t threads : {2, 3, 8}) {
+        aba::set_parallel_options({threads, 64});
+        REQUIRE(aba::detail::product_tree(words) == expected);
+    }
+    aba::set_parallel_options(options);
+}
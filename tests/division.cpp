@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/big_int.hpp>
+#include <abacus/division.hpp>
+#include <abacus/integer.hpp>
+
+#include "random.hpp"
+
+TEMPLATE_TEST_CASE("Recursive division agrees with the schoolbook division", "", uint32_t, uint64_t) {
+    constexpr std::size_t threshold = aba::division_thresholds<TestType>::recursive;
+    uint64_t state = 13;
+
+    const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+        {2 * threshold, threshold},     {4 * threshold, 2 * threshold},      {5 * threshold + 3, 3 * threshold + 1},
+        {3 * threshold, threshold + 7}, {20 * threshold + 1, 3 * threshold}, {8 * threshold, 5 * threshold}};
+    for (const auto& [m, n] : sizes) {
+        // Random values, a divisor with a top limb of one and of all ones, and numerators whose leading limbs equal
+        // the divisor, for the corrections of the quotient.
+        for (int kind = 0; kind < 4; ++kind) {
+            INFO(m << " / " << n << " kind " << kind);
+            auto numerator = test::random_limbs<TestType>(m, state);
+            auto divisor = test::random_limbs<TestType>(n, state);
+            if (kind == 1) {
+                divisor[n - 1] = 1;
+            } else if (kind == 2) {
+                std::fill(divisor.begin(), divisor.end(), ~TestType{0});
+                std::fill(numerator.begin() + 1, numerator.end(), ~TestType{0});
+            } else if (kind == 3) {
+                const auto rest = static_cast<std::ptrdiff_t>(std::min(n - 1, m - n));
+                std::copy(divisor.begin(), divisor.end(), numerator.end() - static_cast<std::ptrdiff_t>(n));
+                std::copy(divisor.end() - rest, divisor.end(), numerator.end() - static_cast<std::ptrdiff_t>(n) - rest);
+            }
+
+            std::vector<TestType> expected_quotient(m - n + 1);
+            std::vector<TestType> expected_remainder(n);
+            std::vector<TestType> scratch(m + n + 1);
+            aba::detail::divrem<TestType>(expected_quotient, expected_remainder, numerator, divisor, scratch);
+
+            std::vector<TestType> quotient(m - n + 1);
+            std::vector<TestType> remainder(n);
+            aba::detail::divide<TestType>(quotient, remainder, numerator, divisor);
+            REQUIRE(quotient == expected_quotient);
+            REQUIRE(remainder == expected_remainder);
+        }
+    }
+}
+
+TEST_CASE("Division of long integers") {
+    uint64_t state = 19;
+    for (const auto& [m, n] : {std::pair<std::size_t, std::size_t>{6000, 2500}, {4000, 3999}, {9000, 200}}) {
+        INFO(m << " / " << n);
+        const auto numerator = aba::Integer::from_limbs(test::random_limbs<uint64_t>(m, state), true);
+        const auto divisor = aba::Integer::from_limbs(test::random_limbs<uint64_t>(n, state));
+        const auto [quotient, remainder] = aba::Integer::division(numerator, divisor);
+        REQUIRE(quotient * divisor + remainder == numerator);
+        REQUIRE(remainder.is_negative());
+        REQUIRE(-remainder < divisor);
+    }
+}
+
+TEST_CASE("Division of wide fixed size integers") {
+    using type = aba::BigUIntN<160>;
+    uint64_t state = 31;
+    for (const std::size_t n : {60, 100, 150}) {
+        std::array<uint64_t, 160> numerator{};
+        std::array<uint64_t, 160> divisor{};
+        const auto numerator_limbs = test::random_limbs<uint64_t>(160, state);
+        const auto divisor_limbs = test::random_limbs<uint64_t>(n, state);
+        std::copy(numerator_limbs.begin(), numerator_limbs.end(), numerator.begin());
+        std::copy(divisor_limbs.begin(), divisor_limbs.end(), divisor.begin());
+
+        const auto [quotient, remainder] = type::division(type(numerator), type(divisor));
+        REQUIRE(remainder < type(divisor));
+        REQUIRE(quotient * type(divisor) + remainder == type(numerator));
+    }
+}
@@ -0,0 +1,91 @@
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/divisor.hpp>
+
+#include "random.hpp"
+
+namespace {
+// Divisors of every size with a top limb of one, all ones and random limbs.
+template <typename T>
+std::vector<T> test_divisors(uint64_t& state) {
+    std::vector<T> divisors = {T(1), T(2), T(3), T(7), T(10), ~T(0)};
+    for (std::size_t limbs = 1; limbs <= T::data_size; ++limbs) {
+        const auto bit = static_cast<uint32_t>((limbs - 1) * T::n_data_bits);
+        divisors.push_back(T(1) << bit);
+        divisors.push_back((T(1) << bit) + T(1));
+        divisors.push_back((T(1) << bit) - T(1));
+        for (int i = 0; i < 4; ++i) {
+            divisors.push_back(test::random_value<T>(limbs, state));
+        }
+        divisors.push_back(test::random_value<T>(limbs, state) >> 7);
+    }
+    std::erase(divisors, T(0));
+    return divisors;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Divisor agrees with the division operators", "", aba::BigUInt, aba::BigUInt256,
+                   (aba::BigUIntN<6, uint32_t>), aba::BigUInt512) {
+    uint64_t state = 5;
+    for (const auto& d : test_divisors<TestType>(state)) {
+        const aba::Divisor<TestType> divisor(d);
+        REQUIRE(divisor.divisor() == d);
+
+        std::vector<TestType> values = {TestType(0), TestType(1), d - TestType(1), d, d + TestType(1), ~TestType(0),
+                                        d * d, d * d - TestType(1)};
+        for (std::size_t limbs = 1; limbs <= TestType::data_size; ++limbs) {
+            for (int i = 0; i < 6; ++i) {
+                values.push_back(test::random_value<TestType>(limbs, state));
+            }
+        }
+        for (const auto& value : values) {
+            INFO(value.to_string(16) << " / " << d.to_string(16));
+            const auto [quotient, remainder] = divisor.division(value);
+            REQUIRE(quotient == value / d);
+            REQUIRE(remainder == value % d);
+            REQUIRE(value / divisor == quotient);
+            REQUIRE(value % divisor == remainder);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Signed divisor truncates like the division operators", "", aba::BigInt, aba::BigInt256,
+                   (aba::BigIntN<3, uint32_t>)) {
+    using unsigned_t = aba::BigUIntN<TestType::data_size, typename TestType::data_t>;
+    uint64_t state = 11;
+    for (const auto& magnitude : test_divisors<unsigned_t>(state)) {
+        for (const auto& d : {TestType(magnitude), -TestType(magnitude)}) {
+            const aba::Divisor<TestType> divisor(d);
+            for (std::size_t limbs = 1; limbs <= TestType::data_size; ++limbs) {
+                const TestType value(test::random_value<unsigned_t>(limbs, state));
+                for (const auto& signed_value : {value, -value}) {
+                    const auto [quotient, remainder] = divisor.division(signed_value);
+                    REQUIRE(quotient == signed_value / d);
+                    REQUIRE(remainder == signed_value % d);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Divisor is constexpr") {
+    constexpr aba::Divisor<aba::BigUInt> by_limb(aba::BigUInt(10));
+    STATIC_REQUIRE(aba::BigUInt(12345) / by_limb == aba::BigUInt(1234));
+    STATIC_REQUIRE(aba::BigUInt(12345) % by_limb == aba::BigUInt(5));
+
+    constexpr aba::Divisor<aba::BigUInt> by_limbs(aba::BigUInt(1) << 64);
+    STATIC_REQUIRE(~aba::BigUInt(0) / by_limbs == aba::BigUInt(~uint64_t{0}));
+
+    constexpr aba::Divisor<aba::BigInt> signed_divisor(aba::BigInt(-7));
+    STATIC_REQUIRE(aba::BigInt(-50) / signed_divisor == aba::BigInt(7));
+    STATIC_REQUIRE(aba::BigInt(-50) % signed_divisor == aba::BigInt(-1));
+}
+
+TEST_CASE("Divisor rejects zero") {
+    REQUIRE_THROWS_AS(aba::Divisor<aba::BigUInt>(aba::BigUInt(0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::Divisor<aba::BigInt>(aba::BigInt(0)), std::invalid_argument);
+}
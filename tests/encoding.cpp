@@ -0,0 +1,142 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/encoding.hpp>
+
+#include "random.hpp"
+
+namespace {
+// Values of every length and sign, with the extremes of T.
+template <typename T>
+std::vector<T> test_values(uint64_t state) {
+    std::vector<T> values = {T(0), T(1), T(127), T(128), T(255), T(256), ~T(0), ~T(0) >> 1};
+    if constexpr (std::is_same_v<T, aba::BigIntN<T::data_size, typename T::data_t>>) {
+        values.insert(values.end(), {T(-1), T(-128), T(-256), T::min(), T::min() + T(1), T::max()});
+    }
+    for (std::size_t bits = 1; bits < T::n_bits; bits += 7) {
+        const auto value = test::random_value<T>(T::data_size, state) >> static_cast<uint32_t>(bits);
+        values.push_back(value);
+        values.push_back(T(0) - value);
+    }
+    return values;
+}
+
+std::vector<std::byte> bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> result;
+    for (const int value : values) {
+        result.push_back(static_cast<std::byte>(value));
+    }
+    return result;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Encoding round trips", "", aba::BigUInt, aba::BigInt, aba::BigUInt256, aba::BigInt256,
+                   (aba::BigUIntN<3, uint32_t>), (aba::BigIntN<3, uint32_t>), aba::BigInt512) {
+    std::array<std::byte, aba::max_encoded_size<TestType>> buffer{};
+    for (const auto& value : test_values<TestType>(3)) {
+        INFO(value.to_string(16));
+        const std::size_t size = aba::encode(value, std::span(buffer));
+        REQUIRE(size == aba::encoded_size(value));
+        const auto [decoded, read] = aba::decode<TestType>(std::span(buffer).first(size));
+        REQUIRE(decoded == value);
+        REQUIRE(read == size);
+        REQUIRE_THROWS_AS(aba::decode<TestType>(std::span(buffer).first(size - 1)), std::invalid_argument);
+        if (size > 1) {
+            REQUIRE_THROWS_AS(aba::encode(value, std::span(buffer).first(size - 1)), std::invalid_argument);
+        }
+    }
+}
+
+TEST_CASE("Encoding is minimal and independent of the width") {
+    std::array<std::byte, aba::max_encoded_size<aba::BigUInt512>> buffer{};
+    const auto encoding = [&](const auto& value) {
+        const auto size = aba::encode(value, std::span(buffer));
+        return std::vector<std::byte>(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+    };
+    REQUIRE(encoding(aba::BigInt(0)) == bytes({0x00}));
+    REQUIRE(encoding(aba::BigInt(1)) == bytes({0x02, 0x01}));
+    REQUIRE(encoding(aba::BigInt(-1)) == bytes({0x03, 0x01}));
+    REQUIRE(encoding(aba::BigUInt(0x1234)) == bytes({0x04, 0x34, 0x12}));
+    REQUIRE(encoding(aba::BigInt256(-0x1234)) == bytes({0x05, 0x34, 0x12}));
+    REQUIRE(encoding(aba::BigUIntN<3, uint32_t>(256)) == bytes({0x04, 0x00, 0x01}));
+    // 64 bytes take a two byte header.
+    REQUIRE(encoding(~aba::BigUInt512(0)).size() == 66);
+    REQUIRE(encoding(~aba::BigUInt512(0))[0] == std::byte{0x80});
+    REQUIRE(encoding(~aba::BigUInt512(0))[1] == std::byte{0x01});
+
+    // Decodes to any type the value fits in.
+    const auto max = encoding(~aba::BigUInt(0));
+    REQUIRE(aba::decode<aba::BigUInt256>(max).first == (aba::BigUInt256(1) << 128) - aba::BigUInt256(1));
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(max), std::out_of_range);
+    REQUIRE_THROWS_AS((aba::decode<aba::BigUIntN<3, uint32_t>>(max)), std::out_of_range);
+    const auto min = encoding(aba::BigInt::min());
+    REQUIRE(aba::decode<aba::BigInt256>(min).first == -(aba::BigInt256(1) << 127));
+    REQUIRE(aba::decode<aba::BigInt>(encoding(-(aba::BigInt256(1) << 127))).first == aba::BigInt::min());
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(encoding(aba::BigInt256(1) << 127)), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(encoding(-(aba::BigInt256(1) << 127) - aba::BigInt256(1))),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigUInt>(encoding(aba::BigInt(-1))), std::out_of_range);
+
+    STATIC_REQUIRE(aba::max_encoded_size<aba::BigInt> == 17);
+    constexpr auto decoded = [] {
+        std::array<std::byte, aba::max_encoded_size<aba::BigInt>> buffer{};
+        aba::encode(aba::BigInt(-123456789), std::span(buffer));
+        return aba::decode<aba::BigInt>(buffer).first;
+    }();
+    STATIC_REQUIRE(decoded == aba::BigInt(-123456789));
+}
+
+TEST_CASE("Decoding rejects invalid encodings") {
+    // A zero byte on top of the magnitude or of the header, and a negative zero.
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(bytes({0x04, 0x01, 0x00})), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(bytes({0x82, 0x00, 0x01})), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(bytes({0x01})), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(bytes({})), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::decode<aba::BigInt>(bytes({0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01})),
+                      std::out_of_range);
+}
+
+TEST_CASE("Batch encoding streams through small buffers") {
+    const auto values = test_values<aba::BigInt256>(5);
+
+    // Encoded into a buffer a little larger than a value and sent on piece by piece.
+    std::vector<std::byte> stream;
+    std::array<std::byte, aba::max_encoded_size<aba::BigInt256> + 3> buffer{};
+    for (std::span<const aba::BigInt256> left(values); !left.empty();) {
+        const auto result = aba::encode_values(left, std::span(buffer));
+        REQUIRE(result.values > 0);
+        stream.insert(stream.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(result.bytes));
+        left = left.subspan(result.values);
+    }
+
+    // Received in pieces cutting through the values, with the bytes not read kept for the next piece.
+    std::vector<aba::BigInt256> decoded;
+    std::vector<std::byte> pending;
+    std::array<aba::BigInt256, 4> out{};
+    for (std::size_t offset = 0; offset < stream.size(); offset += 13) {
+        const auto end = std::min(offset + 13, stream.size());
+        pending.insert(pending.end(), stream.begin() + static_cast<std::ptrdiff_t>(offset),
+                       stream.begin() + static_cast<std::ptrdiff_t>(end));
+        while (true) {
+            const auto result =
+                aba::decode_values(std::span<const std::byte>(pending), std::span<aba::BigInt256>(out));
+            decoded.insert(decoded.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(result.values));
+            pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(result.bytes));
+            if (result.values < out.size()) {
+                break;
+            }
+        }
+    }
+    REQUIRE(pending.empty());
+    REQUIRE(decoded == values);
+
+    const auto all = aba::encode_values(std::span(values), std::span(buffer).first(0));
+    REQUIRE(all.values == 0);
+    REQUIRE(all.bytes == 0);
+}
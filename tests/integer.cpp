@@ -0,0 +1,207 @@
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/big_int.hpp>
+#include <abacus/big_int_functions.hpp>
+#include <abacus/integer.hpp>
+
+#include "random.hpp"
+
+namespace {
+const std::string pow_3_200 =
+    "265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001";
+} // namespace
+
+TEST_CASE("Integer inline storage") {
+    REQUIRE(aba::Integer(0).size() == 0);
+    REQUIRE(aba::Integer(-1).size() == 1);
+    REQUIRE(aba::Integer(std::numeric_limits<int64_t>::min()).to_string() == "-9223372036854775808");
+
+    const auto value = aba::Integer::from_string("170141183460469231731687303715884105727");
+    REQUIRE(value.size() == 2);
+    REQUIRE(value.is_inline());
+    REQUIRE((value * value).is_inline() == false);
+    REQUIRE((value + value).size() == 2);
+    REQUIRE((value + value + value + value).size() == 3);
+}
+
+TEST_CASE("Integer matches BigInt") {
+    // Results that fit in 127 bits must be the same as for the fixed width integers.
+    uint64_t state = 0x2545F4914F6CDD1D;
+    auto next = [&state]() {
+        const uint64_t random = test::next_random(state);
+        return static_cast<int64_t>(random >> (random % 40));
+    };
+
+    for (int i = 0; i < 500; ++i) {
+        const int64_t lhs = next() * (i % 2 == 0 ? 1 : -1);
+        const int64_t rhs = next() * (i % 3 == 0 ? 1 : -1) + 1;
+
+        const aba::Integer a(lhs);
+        const aba::Integer b(rhs);
+        const aba::BigInt big_a(lhs);
+        const aba::BigInt big_b(rhs);
+
+        REQUIRE((a + b).to_string() == (big_a + big_b).to_string());
+        REQUIRE((a - b).to_string() == (big_a - big_b).to_string());
+        REQUIRE((a * b).to_string() == (big_a * big_b).to_string());
+        REQUIRE((a / b).to_string() == (big_a / big_b).to_string());
+        REQUIRE((a % b).to_string() == (big_a % big_b).to_string());
+        REQUIRE((a < b) == (big_a < big_b));
+        REQUIRE((a * b).to_string(16) == (big_a * big_b).to_string(16));
+    }
+}
+
+TEST_CASE("Integer compound operators") {
+    const auto a = aba::Integer::pow(aba::Integer(3), 100);
+    const auto b = -aba::Integer::pow(aba::Integer(7), 30);
+    for (const auto& [lhs, rhs] : {std::pair{a, b}, {b, a}, {a, a}, {b, b}, {a, -a}, {aba::Integer(0), b}}) {
+        auto value = lhs;
+        REQUIRE((value += rhs) == lhs + rhs);
+        REQUIRE((value -= rhs) == lhs);
+        REQUIRE((value -= rhs) == lhs - rhs);
+        REQUIRE((value *= rhs) == (lhs - rhs) * rhs);
+        REQUIRE((value <<= 100) == ((lhs - rhs) * rhs) << 100);
+        REQUIRE((value >>= 170) == (((lhs - rhs) * rhs) << 100) >> 170);
+    }
+
+    // A carry out of the top limb grows the value.
+    auto value = (aba::Integer(1) << 128) - aba::Integer(1);
+    value += aba::Integer(1);
+    REQUIRE(value == aba::Integer(1) << 128);
+    value -= value;
+    REQUIRE(value == aba::Integer(0));
+    REQUIRE(!value.is_negative());
+}
+
+TEST_CASE("Integer growth") {
+    const auto value = aba::Integer::pow(aba::Integer(3), 200);
+    REQUIRE(value.to_string() == pow_3_200);
+    REQUIRE(aba::Integer::from_string(pow_3_200) == value);
+    REQUIRE(aba::Integer::from_string("-" + pow_3_200) == -value);
+    REQUIRE(value.digits(10) == pow_3_200.size());
+    REQUIRE(value.digits(3) == 201);
+    REQUIRE(value.bit_length() == 317);
+
+    const auto divisor = aba::Integer::pow(aba::Integer(7), 50) + 12345;
+    auto [quotient, remainder] = aba::Integer::division(value, divisor);
+    REQUIRE(quotient.to_string() == "147689269781346654697366079240021362540968891926345127");
+    REQUIRE(remainder.to_string() == "1480513908709133232415680991351079358637563");
+
+    std::tie(quotient, remainder) = aba::Integer::division(-value, divisor);
+    REQUIRE(quotient.to_string() == "-147689269781346654697366079240021362540968891926345127");
+    REQUIRE(remainder.to_string() == "-1480513908709133232415680991351079358637563");
+    REQUIRE(quotient * divisor + remainder == -value);
+
+    REQUIRE((aba::Integer(1) << 200 >> 199) == 2);
+    REQUIRE((aba::Integer(1) << 128).to_string(16) == "1" + std::string(32, '0'));
+    REQUIRE(value - value == 0);
+    REQUIRE(!(value - value).is_negative());
+    REQUIRE((value * -value).is_negative());
+    REQUIRE(-value < value);
+    REQUIRE(-value < -divisor);
+}
+
+TEST_CASE("Integer to_chars") {
+    const auto value = -aba::Integer::pow(aba::Integer(3), 200);
+    std::string buffer(pow_3_200.size() + 1, ' ');
+
+    auto result = value.to_chars(buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(buffer == "-" + pow_3_200);
+
+    result = value.to_chars(buffer.data(), buffer.data() + buffer.size() - 1);
+    REQUIRE(result.ec == std::errc::value_too_large);
+}
+
+TEST_CASE("Integer division identity") {
+    uint64_t state = 0x9E3779B97F4A7C15;
+    auto next = [&state]() { return static_cast<int64_t>(test::next_random(state) >> 1); };
+
+    for (uint32_t i = 0; i < 200; ++i) {
+        aba::Integer lhs(1);
+        aba::Integer rhs(1);
+        for (uint32_t j = 0; j <= i % 9; ++j) {
+            lhs = (lhs << 63) + next();
+        }
+        for (uint32_t j = 0; j <= i % 5; ++j) {
+            rhs = (rhs << 63) + (next() >> (i % 60));
+        }
+
+        const auto [quotient, remainder] = aba::Integer::division(lhs, rhs);
+        REQUIRE(remainder < rhs);
+        REQUIRE(quotient * rhs + remainder == lhs);
+    }
+
+    REQUIRE_THROWS_AS(aba::Integer(5) / aba::Integer(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::Integer(-5) % aba::Integer(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::Integer::division(aba::Integer(1) << 200, aba::Integer(0)), std::invalid_argument);
+}
+
+TEST_CASE("Integer roots") {
+    const auto two_e100 = aba::Integer(2) * aba::Integer::pow(aba::Integer(10), 100);
+    REQUIRE(aba::sqrt(two_e100).to_string() == "141421356237309504880168872420969807856967187537694");
+    REQUIRE(aba::root(aba::Integer(1) << 300, 3) == aba::Integer(1) << 100);
+    REQUIRE(aba::root(aba::Integer::from_string("170141183460469231731687303715884105727"), 11).to_string() == "2989");
+}
+
+TEST_CASE("Integer large radix conversion") {
+    // Powers of the base and their neighbours have runs of zeros and of maximal digits at every split point.
+    for (const uint32_t base : {2U, 7U, 10U}) {
+        const auto power = aba::Integer::pow(aba::Integer(base), 20000);
+        const char max_digit = aba::BigUInt::representation[base - 1];
+
+        REQUIRE(power.to_string(static_cast<uint16_t>(base)) == "1" + std::string(20000, '0'));
+        REQUIRE((power - 1).to_string(static_cast<uint16_t>(base)) == std::string(20000, max_digit));
+        REQUIRE(aba::Integer::from_string("1" + std::string(20000, '0'), base) == power);
+        REQUIRE(power.digits(base) == 20001);
+        REQUIRE((power - 1).digits(base) == 20000);
+        REQUIRE((1 - power).digits(base) == 20000);
+    }
+
+    std::string digits;
+    uint64_t state = 17;
+    for (int i = 0; i < 30011; ++i) {
+        digits.push_back(static_cast<char>('0' + (test::next_random(state) >> 33) % 10));
+    }
+    digits[0] = '9';
+    digits[1000] = '0';
+
+    const auto value = aba::Integer::from_string("-" + digits);
+    REQUIRE(value.to_string() == "-" + digits);
+    REQUIRE(value.size() == 1558);
+    REQUIRE(value.digits(10) == digits.size());
+    REQUIRE(value.digits(36) == value.to_string(36).size() - 1);
+    REQUIRE(aba::Integer::from_string(value.to_string(3), 3) == value);
+
+    std::string buffer(digits.size(), '\0');
+    REQUIRE(value.to_chars(buffer.data(), buffer.data() + buffer.size()).ec == std::errc::value_too_large);
+    buffer.push_back('\0');
+    const auto [end, ec] = value.to_chars(buffer.data(), buffer.data() + buffer.size());
+    REQUIRE(ec == std::errc{});
+    REQUIRE(end == buffer.data() + buffer.size());
+    REQUIRE(buffer == "-" + digits);
+}
+
+TEST_CASE("Integer from chars") {
+    aba::Integer value(42);
+    const std::string empty = "-x";
+    auto result = aba::Integer::from_chars(empty.data(), empty.data() + empty.size(), value);
+    REQUIRE(result.ec == std::errc::invalid_argument);
+    REQUIRE(result.ptr == empty.data());
+    REQUIRE(value == 42);
+
+    const std::string hex = "-ffffffffffffffffffffffffffffffffFFFFFFFFFFFFFFFF,";
+    result = aba::Integer::from_chars(hex.data(), hex.data() + hex.size(), value, 16);
+    REQUIRE(result.ec == std::errc{});
+    REQUIRE(*result.ptr == ',');
+    REQUIRE(value == -((aba::Integer(1) << 192) - 1));
+
+    REQUIRE(aba::Integer::from_string("-0") == 0);
+    REQUIRE(!aba::Integer::from_string("-0").is_negative());
+    REQUIRE(aba::Integer::from_string("zZ", 36) == 35 * 36 + 35);
+    REQUIRE_THROWS_AS(aba::Integer::from_string("12 "), std::invalid_argument);
+    REQUIRE_THROWS_AS(aba::Integer::from_string("2", 2), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/modular.hpp>
+
+#include "random.hpp"
+
+namespace {
+// lhs * rhs mod modulus through a product twice as wide and a full division.
+template <std::size_t Limbs, typename Limb>
+aba::BigUIntN<Limbs, Limb> reference_mulmod(const aba::BigUIntN<Limbs, Limb>& lhs,
+                                            const aba::BigUIntN<Limbs, Limb>& rhs,
+                                            const aba::BigUIntN<Limbs, Limb>& modulus) {
+    using wide_t = aba::BigUIntN<2 * Limbs, Limb>;
+    auto widen = [](const aba::BigUIntN<Limbs, Limb>& value) {
+        std::array<Limb, 2 * Limbs> data{};
+        std::copy(value.limbs().begin(), value.limbs().end(), data.begin());
+        return wide_t(data);
+    };
+
+    const wide_t product = (widen(lhs) % widen(modulus)) * (widen(rhs) % widen(modulus)) % widen(modulus);
+    std::array<Limb, Limbs> data{};
+    std::copy_n(product.limbs().begin(), Limbs, data.begin());
+    return aba::BigUIntN<Limbs, Limb>(data);
+}
+
+template <std::size_t Limbs, typename Limb, std::size_t ExponentLimbs>
+aba::BigUIntN<Limbs, Limb> reference_powmod(const aba::BigUIntN<Limbs, Limb>& base,
+                                            const aba::BigUIntN<ExponentLimbs, Limb>& exponent,
+                                            const aba::BigUIntN<Limbs, Limb>& modulus) {
+    aba::BigUIntN<Limbs, Limb> result = aba::BigUIntN<Limbs, Limb>(1) % modulus;
+    for (std::size_t i = aba::BigUIntN<ExponentLimbs, Limb>::n_bits; i > 0; --i) {
+        result = reference_mulmod(result, result, modulus);
+        const Limb limb = exponent.limbs()[(i - 1) / aba::detail::limb_bits<Limb>];
+        if (((limb >> ((i - 1) % aba::detail::limb_bits<Limb>)) & 1) != 0) {
+            result = reference_mulmod(result, base, modulus);
+        }
+    }
+    return result;
+}
+
+constexpr bool constant_powmod() {
+    const aba::Modulus<aba::BigUInt> modulus(aba::BigUInt(97));
+    return modulus.powmod(aba::BigUInt(3), aba::BigUInt(96)) == 1 && modulus.mulmod(96, 96) == 1 &&
+           aba::Modulus<aba::BigUInt>(aba::BigUInt(1000)).powmod(aba::BigUInt(7), aba::BigUInt(3)) == 343;
+}
+} // namespace
+
+TEST_CASE("Modular arithmetic in constant evaluation") { STATIC_REQUIRE(constant_powmod()); }
+
+TEST_CASE("Modular exponentiation") {
+    // Fermat's little theorem for the Mersenne prime 2^127 - 1.
+    const aba::BigUInt prime = (aba::BigUInt(1) << 127) - 1;
+    const aba::Modulus<aba::BigUInt> modulus(prime);
+    REQUIRE(modulus.is_montgomery());
+    for (const uint64_t base : {2ULL, 3ULL, 65537ULL, 0xFFFF'FFFF'FFFF'FFFFULL}) {
+        REQUIRE(modulus.powmod(aba::BigUInt(base), prime - 1) == 1);
+        REQUIRE(modulus.powmod(aba::BigUInt(base), prime) == base);
+    }
+    REQUIRE(modulus.powmod(prime, aba::BigUInt(5)) == 0);
+    REQUIRE(modulus.powmod(aba::BigUInt(5), aba::BigUInt(0)) == 1);
+
+    // An even modulus uses Barrett reduction only.
+    const aba::Modulus<aba::BigUInt> even(aba::BigUInt(1) << 100);
+    REQUIRE(!even.is_montgomery());
+    REQUIRE(even.powmod(aba::BigUInt(3), aba::BigUInt(1) << 98) == 1);
+    REQUIRE(even.powmod(aba::BigUInt(2), aba::BigUInt(100)) == 0);
+
+    REQUIRE(aba::Modulus<aba::BigUInt>(1).powmod(aba::BigUInt(5), aba::BigUInt(0)) == 0);
+    REQUIRE_THROWS_AS(aba::Modulus<aba::BigUInt>(0), std::invalid_argument);
+}
+
+TEMPLATE_TEST_CASE("Modular arithmetic agrees with division", "", aba::BigUInt256, (aba::BigUIntN<6, uint32_t>),
+                   aba::BigUInt512) {
+    using data_t = typename TestType::data_t;
+    using exponent_t = aba::BigUIntN<3, data_t>;
+
+    uint64_t state = 17;
+    for (std::size_t limbs = 1; limbs <= TestType::data_size; ++limbs) {
+        // Odd and even moduli, and B^(k - 1) which needs the largest Barrett constant.
+        const auto random = test::random_value<TestType>(limbs, state);
+        const std::vector<TestType> moduli = {
+            random, random - (random % 2) + 1, random - (random % 2),
+            TestType(1) << static_cast<uint32_t>((limbs - 1) * TestType::n_data_bits)};
+        for (const auto& value : moduli) {
+            if (value == 0) {
+                continue;
+            }
+            const aba::Modulus<TestType> modulus(value);
+            for (int i = 0; i < 4; ++i) {
+                const auto lhs = test::random_value<TestType>(i == 0 ? TestType::data_size : limbs, state);
+                const auto rhs = test::random_value<TestType>(limbs, state);
+                REQUIRE(modulus.reduce(lhs) == lhs % value);
+                REQUIRE(modulus.mulmod(lhs, rhs) == reference_mulmod(lhs, rhs, value));
+                REQUIRE(modulus.sqrmod(lhs) == reference_mulmod(lhs, lhs, value));
+
+                const auto exponent_limbs =
+                    std::min<std::size_t>(static_cast<std::size_t>(i) + 1, exponent_t::data_size);
+                const auto exponent = test::random_value<exponent_t>(exponent_limbs, state);
+                REQUIRE(modulus.powmod(lhs, exponent) == reference_powmod(lhs, exponent, value));
+            }
+        }
+    }
+}
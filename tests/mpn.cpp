@@ -0,0 +1,197 @@
+#include <array>
+#include <compare>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/mpn.hpp>
+
+#include "random.hpp"
+
+namespace {
+constexpr bool constant_kernels() {
+    std::array<uint64_t, 3> lhs = {~uint64_t{0}, ~uint64_t{0}, 1};
+    const std::array<uint64_t, 3> rhs = {1, 0, 0};
+    std::array<uint64_t, 3> result{};
+    if (aba::detail::add_n<uint64_t>(result, lhs, rhs) != 0 || result != std::array<uint64_t, 3>{0, 0, 2}) {
+        return false;
+    }
+    if (aba::detail::sub_n<uint64_t>(result, rhs, lhs) != 1 ||
+        result != std::array<uint64_t, 3>{2, 0, ~uint64_t{0} - 1}) {
+        return false;
+    }
+    if (aba::detail::lshift<uint64_t>(result, lhs, 1) != 0 ||
+        result != std::array<uint64_t, 3>{~uint64_t{0} - 1, ~uint64_t{0}, 3}) {
+        return false;
+    }
+    if (aba::detail::addmul_1<uint64_t>(lhs, rhs, 2) != 0 || lhs != std::array<uint64_t, 3>{1, 0, 2}) {
+        return false;
+    }
+    return aba::detail::cmp<uint64_t>(lhs, rhs) > 0;
+}
+} // namespace
+
+TEST_CASE("Limb kernels in constant evaluation") { STATIC_REQUIRE(constant_kernels()); }
+
+TEMPLATE_TEST_CASE("Limb kernels agree with portable versions", "", uint32_t, uint64_t) {
+    namespace portable = aba::detail::portable;
+
+    uint64_t state = 7;
+    for (const std::size_t size : {1, 2, 3, 8, 31}) {
+        for (const bool ones : {false, true}) {
+            auto lhs = test::random_limbs<TestType>(size, state);
+            auto rhs = test::random_limbs<TestType>(size, state);
+            if (ones) {
+                std::fill(lhs.begin(), lhs.end(), ~TestType{0});
+                std::fill(rhs.begin(), rhs.end(), ~TestType{0});
+            }
+            const TestType factor = ones ? ~TestType{0} : rhs[0];
+
+            std::vector<TestType> expected(size);
+            std::vector<TestType> result(size);
+
+            TestType carry = portable::add_n<TestType>(expected, lhs, rhs);
+            REQUIRE(aba::detail::add_n<TestType>(result, lhs, rhs) == carry);
+            REQUIRE(result == expected);
+
+            carry = portable::sub_n<TestType>(expected, lhs, rhs);
+            REQUIRE(aba::detail::sub_n<TestType>(result, lhs, rhs) == carry);
+            REQUIRE(result == expected);
+
+            carry = portable::mul_1<TestType>(expected, lhs, factor);
+            REQUIRE(aba::detail::mul_1<TestType>(result, lhs, factor) == carry);
+            REQUIRE(result == expected);
+
+            expected = rhs;
+            result = rhs;
+            carry = portable::addmul_1<TestType>(expected, lhs, factor);
+            REQUIRE(aba::detail::addmul_1<TestType>(result, lhs, factor) == carry);
+            REQUIRE(result == expected);
+
+            expected = rhs;
+            result = rhs;
+            carry = portable::submul_1<TestType>(expected, lhs, factor);
+            REQUIRE(aba::detail::submul_1<TestType>(result, lhs, factor) == carry);
+            REQUIRE(result == expected);
+
+            // (rhs - lhs * factor) + lhs * factor restores rhs, including the limb borrowed and carried out.
+            REQUIRE(aba::detail::addmul_1<TestType>(result, lhs, factor) == carry);
+            REQUIRE(result == rhs);
+        }
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST_CASE("Limb kernel variants") {
+    namespace portable = aba::detail::portable;
+
+    STATIC_REQUIRE(aba::kernels_from_string("bmi2_adx") == aba::CpuKernels::bmi2_adx);
+    STATIC_REQUIRE(!aba::kernels_from_string("avx"));
+    REQUIRE(aba::is_supported(aba::cpu_kernels(), aba::cpu_features()));
+
+    const aba::CpuFeatures features = aba::cpu_features();
+    uint64_t state = 5;
+    for (const auto kernels : {aba::CpuKernels::baseline, aba::CpuKernels::bmi2_adx}) {
+        if (!aba::is_supported(kernels, features)) {
+            continue;
+        }
+        INFO(aba::to_string(kernels));
+        const auto& table = aba::detail::kernel_table(kernels);
+        for (const std::size_t size : {0, 1, 3, 4, 5, 8, 13, 64}) {
+            for (const bool ones : {false, true}) {
+                auto lhs = test::random_limbs<uint64_t>(size, state);
+                auto rhs = test::random_limbs<uint64_t>(size, state);
+                if (ones) {
+                    std::fill(lhs.begin(), lhs.end(), ~uint64_t{0});
+                    std::fill(rhs.begin(), rhs.end(), ~uint64_t{0});
+                }
+                const uint64_t factor = ones ? ~uint64_t{0} : state;
+
+                std::vector<uint64_t> expected(size);
+                std::vector<uint64_t> result(size);
+
+                REQUIRE(table.add_n(result.data(), lhs.data(), rhs.data(), size) ==
+                        portable::add_n<uint64_t>(expected, lhs, rhs));
+                REQUIRE(result == expected);
+
+                REQUIRE(table.sub_n(result.data(), lhs.data(), rhs.data(), size) ==
+                        portable::sub_n<uint64_t>(expected, lhs, rhs));
+                REQUIRE(result == expected);
+
+                REQUIRE(table.mul_1(result.data(), lhs.data(), size, factor) ==
+                        portable::mul_1<uint64_t>(expected, lhs, factor));
+                REQUIRE(result == expected);
+
+                expected = rhs;
+                result = rhs;
+                REQUIRE(table.addmul_1(result.data(), lhs.data(), size, factor) ==
+                        portable::addmul_1<uint64_t>(expected, lhs, factor));
+                REQUIRE(result == expected);
+
+                REQUIRE(table.submul_1(result.data(), lhs.data(), size, factor) ==
+                        portable::submul_1<uint64_t>(expected, lhs, factor));
+                REQUIRE(result == expected);
+
+                // In place, as used by the integer types.
+                expected = lhs;
+                result = lhs;
+                REQUIRE(table.add_n(result.data(), result.data(), rhs.data(), size) ==
+                        portable::add_n<uint64_t>(expected, expected, rhs));
+                REQUIRE(result == expected);
+            }
+        }
+    }
+}
+#endif
+
+TEMPLATE_TEST_CASE("Limb shifts", "", uint32_t, uint64_t) {
+    constexpr uint32_t bits = aba::detail::limb_bits<TestType>;
+    uint64_t state = 11;
+    const auto value = test::random_limbs<TestType>(5, state);
+
+    for (uint32_t shift = 0; shift < bits; shift += 7) {
+        std::vector<TestType> shifted(5);
+        const TestType out = aba::detail::lshift<TestType>(shifted, value, shift);
+        REQUIRE(out == (shift == 0 ? 0 : value[4] >> (bits - shift)));
+
+        std::vector<TestType> restored(5);
+        aba::detail::rshift<TestType>(restored, shifted, shift);
+        restored[4] = static_cast<TestType>(restored[4] | (shift == 0 ? 0 : out << (bits - shift)));
+        REQUIRE(restored == value);
+
+        // In place, shifting by a limb offset in the direction the kernels allow.
+        std::vector<TestType> buffer(7);
+        std::copy(value.begin(), value.end(), buffer.begin());
+        buffer[6] = aba::detail::lshift<TestType>(std::span(buffer).subspan(1, 5), std::span(buffer).first(5), shift);
+        REQUIRE(buffer[0] == value[0]);
+        aba::detail::rshift<TestType>(std::span(buffer).first(5), std::span(buffer).subspan(1, 5), shift);
+        buffer[4] = static_cast<TestType>(buffer[4] | (shift == 0 ? 0 : buffer[6] << (bits - shift)));
+        REQUIRE(std::equal(value.begin(), value.end(), buffer.begin()));
+    }
+}
+
+TEMPLATE_TEST_CASE("Long division kernel", "", uint32_t, uint64_t) {
+    uint64_t state = 3;
+    for (const auto& [m, n] : {std::pair<std::size_t, std::size_t>{2, 2}, {5, 2}, {9, 4}, {16, 15}, {20, 7}}) {
+        const auto numerator = test::random_limbs<TestType>(m, state);
+        auto divisor = test::random_limbs<TestType>(n, state);
+        divisor[n - 1] = static_cast<TestType>(divisor[n - 1] >> (n % 5));
+
+        std::vector<TestType> quotient(m - n + 1);
+        std::vector<TestType> remainder(n);
+        std::vector<TestType> scratch(m + n + 1);
+        aba::detail::divrem<TestType>(quotient, remainder, numerator, divisor, scratch);
+
+        // remainder < divisor and quotient * divisor + remainder == numerator.
+        REQUIRE(std::is_lt(aba::detail::cmp<TestType>(remainder, divisor)));
+        std::vector<TestType> product(m + 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            product[i + quotient.size()] =
+                aba::detail::addmul_1<TestType>(std::span(product).subspan(i), quotient, divisor[i]);
+        }
+        REQUIRE(aba::detail::add_in_place<TestType>(product, remainder) == 0);
+        REQUIRE(product[m] == 0);
+        REQUIRE(std::equal(numerator.begin(), numerator.end(), product.begin()));
+    }
+}
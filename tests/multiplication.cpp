@@ -0,0 +1,88 @@
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/integer.hpp>
+#include <abacus/multiplication.hpp>
+
+#include "random.hpp"
+
+TEMPLATE_TEST_CASE("Multiplication algorithms agree with schoolbook", "", uint32_t, uint64_t) {
+    using thresholds = aba::multiplication_thresholds<TestType>;
+
+    // Sizes around every threshold, balanced and unbalanced, plus all-ones operands for maximal carries.
+    const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+        {thresholds::karatsuba - 1, thresholds::karatsuba - 1},
+        {thresholds::karatsuba, thresholds::karatsuba},
+        {thresholds::karatsuba + 1, thresholds::karatsuba},
+        {3 * thresholds::karatsuba, thresholds::karatsuba},
+        {2 * thresholds::karatsuba + 1, thresholds::karatsuba + 1},
+        {thresholds::toom3, thresholds::toom3},
+        {thresholds::toom3 + 1, thresholds::toom3 - 1},
+        {thresholds::toom3 + 2, thresholds::toom3},
+        {3 * thresholds::toom3 + 7, 2 * thresholds::toom3 + 1},
+    };
+
+    uint64_t state = 42;
+    for (const auto& [lhs_size, rhs_size] : sizes) {
+        for (const bool ones : {false, true}) {
+            auto lhs = test::random_limbs<TestType>(lhs_size, state);
+            auto rhs = test::random_limbs<TestType>(rhs_size, state);
+            if (ones) {
+                std::fill(lhs.begin(), lhs.end(), ~TestType{0});
+                std::fill(rhs.begin(), rhs.end(), ~TestType{0});
+            }
+
+            std::vector<TestType> expected(lhs_size + rhs_size);
+            std::vector<TestType> result(lhs_size + rhs_size);
+            aba::detail::mul_basecase<TestType>(expected, lhs, rhs);
+            aba::detail::multiply<TestType>(result, lhs, rhs);
+            REQUIRE(result == expected);
+
+            aba::detail::multiply<TestType>(result, rhs, lhs);
+            REQUIRE(result == expected);
+
+            std::vector<TestType> square(2 * lhs_size);
+            expected.resize(2 * lhs_size);
+            aba::detail::mul_basecase<TestType>(expected, lhs, lhs);
+            aba::detail::square<TestType>(square, lhs);
+            REQUIRE(square == expected);
+
+            aba::detail::sqr_karatsuba<TestType>(square, lhs);
+            REQUIRE(square == expected);
+
+            aba::detail::mul_toom3<TestType>(square, lhs, lhs, true);
+            REQUIRE(square == expected);
+        }
+    }
+}
+
+TEST_CASE("Integer multiplication of large values") {
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1, i.e. n - 1 nines, an eight, n - 1 zeros and a one.
+    const std::size_t n = 20000;
+    const auto nines = aba::Integer::pow(aba::Integer(10), n) - 1;
+    const auto expected = std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1";
+    REQUIRE((nines * nines).to_string() == expected);
+    REQUIRE((nines * (nines + 0)).to_string() == expected);
+
+    const auto other = nines + 2;
+    REQUIRE(((nines * other) - nines * nines) == nines * 2);
+}
+
+TEMPLATE_TEST_CASE("Fixed width multiplication and squaring", "", aba::BigUInt, aba::BigUInt1024,
+                   (aba::BigUIntN<16, uint32_t>), (aba::BigUIntN<64>)) {
+    // 3^k for the largest k that fits, computed through squares as well as plain products.
+    TestType value(1);
+    aba::Integer expected(1);
+    while ((expected * 3).bit_length() <= TestType::n_bits) {
+        value = value * TestType(3);
+        expected = expected * 3;
+    }
+    REQUIRE(value.to_string(10) == expected.to_string());
+
+    const auto square = value * value;
+    REQUIRE(square == value * (value + TestType(1)) - value);
+    REQUIRE(square.to_string(16) ==
+            (expected * expected % (aba::Integer(1) << static_cast<uint32_t>(TestType::n_bits))).to_string(16));
+}
@@ -0,0 +1,99 @@
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/integer.hpp>
+#include <abacus/multiplication.hpp>
+#include <abacus/ntt.hpp>
+
+#include "random.hpp"
+
+namespace {
+std::vector<uint64_t> random_limbs(std::size_t size, uint64_t& state) {
+    return test::random_limbs<uint64_t>(size, state);
+}
+
+aba::Integer from_limbs(const std::vector<uint64_t>& limbs) {
+    aba::Integer result(0);
+    for (std::size_t i = limbs.size(); i > 0; --i) {
+        result = (result << 64) + aba::Integer(static_cast<int64_t>(limbs[i - 1] >> 1)) * 2 +
+                 aba::Integer(static_cast<int64_t>(limbs[i - 1] & 1));
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("Number theoretic transform modular arithmetic") {
+    using prime = aba::detail::NttPrime1;
+
+    const uint64_t a = prime::to_montgomery(123456789);
+    const uint64_t b = prime::to_montgomery(987654321);
+    CHECK(prime::from_montgomery(prime::mul(a, b)) == (uint64_t{123456789} * 987654321) % prime::prime);
+    CHECK(prime::from_montgomery(prime::pow(a, prime::prime - 1)) == 1);
+    CHECK(prime::max_log_size >= 50);
+}
+
+TEST_CASE("Number theoretic transform multiplication") {
+    const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+        {1, 1}, {2, 1}, {7, 3}, {64, 64}, {100, 37}, {513, 511}, {1000, 3},
+    };
+
+    uint64_t state = 7;
+    for (const auto& [lhs_size, rhs_size] : sizes) {
+        for (const bool ones : {false, true}) {
+            auto lhs = random_limbs(lhs_size, state);
+            auto rhs = random_limbs(rhs_size, state);
+            if (ones) {
+                std::fill(lhs.begin(), lhs.end(), ~uint64_t{0});
+                std::fill(rhs.begin(), rhs.end(), ~uint64_t{0});
+            }
+
+            std::vector<uint64_t> expected(lhs_size + rhs_size);
+            std::vector<uint64_t> result(lhs_size + rhs_size);
+            aba::detail::mul_basecase<uint64_t>(expected, lhs, rhs);
+            aba::detail::mul_ntt(result, lhs, rhs);
+            CHECK(result == expected);
+
+            result.resize(2 * lhs_size);
+            aba::detail::mul_ntt(result, lhs, lhs);
+            expected.resize(2 * lhs_size);
+            aba::detail::sqr_basecase<uint64_t>(expected, lhs);
+            CHECK(result == expected);
+        }
+    }
+}
+
+TEST_CASE("Number theoretic transform dispatch") {
+    using thresholds = aba::multiplication_thresholds<uint64_t>;
+
+    uint64_t state = 11;
+    const auto lhs = random_limbs(thresholds::ntt + 5, state);
+    const auto rhs = random_limbs(thresholds::ntt, state);
+
+    std::vector<uint64_t> expected(lhs.size() + rhs.size());
+    std::vector<uint64_t> result(lhs.size() + rhs.size());
+    aba::detail::mul_toom3<uint64_t>(expected, lhs, rhs, false);
+    aba::detail::multiply<uint64_t>(result, lhs, rhs);
+    CHECK(result == expected);
+
+    expected.resize(2 * lhs.size());
+    result.resize(2 * lhs.size());
+    aba::detail::mul_toom3<uint64_t>(expected, lhs, lhs, true);
+    aba::detail::square<uint64_t>(result, lhs);
+    CHECK(result == expected);
+}
+
+TEST_CASE("Multiplier with cached transform") {
+    using thresholds = aba::multiplication_thresholds<uint64_t>;
+
+    uint64_t state = 13;
+    const auto operand = -from_limbs(random_limbs(thresholds::ntt, state));
+    aba::Multiplier multiplier(operand);
+
+    for (const std::size_t size : {std::size_t{3}, thresholds::ntt, 2 * thresholds::ntt, thresholds::ntt}) {
+        const auto value = from_limbs(random_limbs(size, state));
+        CHECK(multiplier.multiply(value) == operand * value);
+        CHECK(multiplier.multiply(-value) == operand * -value);
+    }
+    CHECK(multiplier.multiply(0) == 0);
+}
@@ -1,3 +1,6 @@
+#include <limits>
+#include <stdexcept>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <abacus/number.hpp>
@@ -41,11 +44,55 @@ TEST_CASE("Number to_string") {
 }
 
 TEST_CASE("Number Addition") {
-    //
+    REQUIRE(aba::Number(3, 2) + aba::Number(1, 0) == aba::Number(13, 0));
+    REQUIRE(aba::Number(1, 0) + aba::Number(-3, 2) == aba::Number(-11, 0));
+    REQUIRE(aba::Number(1, 70) + aba::Number(1, 0) == aba::Number(aba::BigInt(1) << 70, 0) + aba::Number(1));
+    REQUIRE((aba::Number(5, 40) + aba::Number(3, -2)).to_double() == 5497558138880.75);
+}
+
+TEST_CASE("Number Addition of distant exponents") {
+    constexpr int32_t max = std::numeric_limits<int32_t>::max();
+    constexpr int32_t min = std::numeric_limits<int32_t>::min();
+    REQUIRE_THROWS_AS(aba::Number(1, max) + aba::Number(1, -1), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(1, min) - aba::Number(1, max), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(1, max) - aba::Number(1, min), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(1, 128) + aba::Number(1, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(1, 127) + aba::Number(1, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(-1, 127) - aba::Number(1, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::Number(1, 0) - aba::Number(2, 126), std::out_of_range);
+    REQUIRE((aba::Number(1, 126) + aba::Number(1, 0)).mantissa() == (aba::BigInt(1) << 126) + aba::BigInt(1));
+
+    // A zero mantissa can be moved to any exponent.
+    REQUIRE((aba::Number(0, max) + aba::Number(3, min)).mantissa() == aba::BigInt(3));
+    REQUIRE((aba::Number(3, min) - aba::Number(0, max)).mantissa() == aba::BigInt(3));
+    REQUIRE((aba::Number(1, 100) + aba::Number(1, 0)).mantissa() == (aba::BigInt(1) << 100) + aba::BigInt(1));
+}
+
+TEST_CASE("Number Comparison of distant exponents") {
+    constexpr int32_t max = std::numeric_limits<int32_t>::max();
+    constexpr int32_t min = std::numeric_limits<int32_t>::min();
+    REQUIRE(aba::Number(1, 200) > aba::Number(1, 0));
+    REQUIRE(aba::Number(1, 200) != aba::Number(1, 0));
+    REQUIRE_FALSE(aba::Number(1, 200) == aba::Number(1, 0));
+    REQUIRE(aba::Number(-1, 200) < aba::Number(-1, 0));
+    REQUIRE(aba::Number(-1, max) < aba::Number(1, min));
+    REQUIRE(aba::Number(1, max) > aba::Number(1, min));
+    REQUIRE(aba::Number(0, max) < aba::Number(1, min));
+    REQUIRE(aba::Number(0, max) == aba::Number(0, min));
+
+    // Equal leading bits compare the aligned mantissas.
+    REQUIRE(aba::Number(1, 127) == aba::Number(aba::BigInt::max() / 2 + 1, 1));
+    REQUIRE(aba::Number(3, 126) > aba::Number(aba::BigInt::max(), 0));
+    REQUIRE(aba::Number(aba::BigInt::min(), 0) == aba::Number(-1, 127));
+    REQUIRE(aba::Number(aba::BigInt::min() + 1, 0) > aba::Number(-1, 127));
+    REQUIRE(aba::Number(-5, 3) < aba::Number(-9, 2));
 }
 
 TEST_CASE("Number Subtraction") {
-    //
+    REQUIRE(aba::Number(3, 2) - aba::Number(1, 0) == aba::Number(11, 0));
+    REQUIRE(aba::Number(1, 0) - aba::Number(3, 2) == aba::Number(-11, 0));
+    REQUIRE(aba::Number(-1, 0) - aba::Number(-3, 2) == aba::Number(11, 0));
+    REQUIRE((aba::Number(3, -2) - aba::Number(5, 40)).to_double() == -5497558138879.25);
 }
 
 TEST_CASE("Number Multiplication") {
@@ -57,3 +104,12 @@ TEST_CASE("Number Division") {
     REQUIRE(aba::Number(-346245245546, -43465710) / aba::Number(-346245245546, -43465712) == aba::Number(4, 0));
     REQUIRE(aba::Number(-346245245546, -43465712) / aba::Number(-346245245546, -43465710) == aba::Number(1, -2));
 }
+
+TEST_CASE("Number formatting") {
+    REQUIRE(fmt::format("{}", aba::Number(6841735714)) == "6841735714");
+    REQUIRE(fmt::format("{}", aba::Number(3, 44)) == "3p44");
+    REQUIRE(fmt::format("{}", aba::Number(-3, -44)) == "-3p-44");
+    REQUIRE(fmt::format("{:#x}", aba::Number(255, -2147483647 - 1)) == "0xffp-2147483648");
+    REQUIRE(fmt::format("{:>8}", aba::Number(3, 4)) == "     3p4");
+    REQUIRE(fmt::format("{:010,}", aba::Number(1000, 1)) == "0001,000p1");
+}
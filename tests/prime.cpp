@@ -0,0 +1,103 @@
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/prime.hpp>
+
+namespace {
+std::vector<bool> sieve(std::size_t size) {
+    std::vector<bool> prime(size, true);
+    prime[0] = false;
+    prime[1] = false;
+    for (std::size_t i = 2; i * i < size; ++i) {
+        for (std::size_t j = i * i; prime[i] && j < size; j += i) {
+            prime[j] = false;
+        }
+    }
+    return prime;
+}
+} // namespace
+
+TEST_CASE("Primality in constant evaluation") {
+    STATIC_REQUIRE(aba::is_probable_prime(aba::BigUInt(1'000'003)));
+    STATIC_REQUIRE(!aba::is_probable_prime(aba::BigUInt(1'000'001)));
+}
+
+TEMPLATE_TEST_CASE("Primality of small values", "", aba::BigUInt, (aba::BigUIntN<3, uint32_t>), aba::BigInt) {
+    const auto prime = sieve(5000);
+    for (uint32_t value = 0; value < prime.size(); ++value) {
+        INFO(value);
+        REQUIRE(aba::is_probable_prime(TestType(value)) == prime[value]);
+    }
+    // Past the trial division by the primes below 1024.
+    for (uint32_t value = (1 << 20) - 2000; value < (1 << 20) + 2000; ++value) {
+        INFO(value);
+        bool expected = value % 2 != 0;
+        for (uint32_t d = 3; expected && d * d <= value; d += 2) {
+            expected = value % d != 0;
+        }
+        REQUIRE(aba::is_probable_prime(TestType(value)) == expected);
+    }
+}
+
+TEMPLATE_TEST_CASE("Primality of large values", "", aba::BigUInt, (aba::BigUIntN<4, uint32_t>), aba::BigUInt256) {
+    const auto mersenne = [](uint32_t exponent) { return (TestType(1) << exponent) - 1; };
+    REQUIRE(aba::is_probable_prime(mersenne(61)));
+    REQUIRE(aba::is_probable_prime(mersenne(89)));
+    REQUIRE(aba::is_probable_prime(mersenne(107)));
+    REQUIRE(aba::is_probable_prime(mersenne(127)));
+    REQUIRE(!aba::is_probable_prime(mersenne(67)));
+    REQUIRE(!aba::is_probable_prime(mersenne(101)));
+
+    // Carmichael numbers and strong pseudoprimes to the first few prime bases.
+    for (const uint64_t value : {561ULL, 41041ULL, 3215031751ULL, 2152302898747ULL, 3825123056546413051ULL}) {
+        REQUIRE(!aba::is_probable_prime(TestType(value)));
+    }
+    // The square of a prime and a strong pseudoprime to base 2 (6k + 1)(12k + 1)(18k + 1) above 78 bits, both left to
+    // the Lucas test.
+    const TestType square = TestType(1099511627791) * TestType(1099511627791);
+    REQUIRE(square.bit_length() > 78);
+    REQUIRE(!aba::is_probable_prime(square));
+    const TestType pseudoprime = TestType(402665017) * TestType(805330033) * TestType(1207995049);
+    REQUIRE(!aba::is_probable_prime(pseudoprime));
+    REQUIRE(aba::is_probable_prime(TestType(1099511627791)));
+
+    if constexpr (TestType::n_bits == 128) {
+        REQUIRE(aba::is_probable_prime(TestType(0) - 159));
+        REQUIRE(!aba::is_probable_prime(TestType(0) - 161));
+    }
+}
+
+TEST_CASE("Primality of signed values") {
+    REQUIRE(aba::is_probable_prime(aba::BigInt(7)));
+    REQUIRE(!aba::is_probable_prime(aba::BigInt(-7)));
+    REQUIRE(aba::next_prime(aba::BigInt(-7)) == 2);
+    REQUIRE(aba::next_prime(aba::BigInt(13)) == 17);
+    // The largest positive BigInt is the prime 2^127 - 1.
+    const aba::BigInt largest = (aba::BigInt(1) << 127) - 1;
+    REQUIRE(aba::next_prime(largest - 2) == largest);
+    REQUIRE_THROWS_AS(aba::next_prime(largest), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("Next prime", "", aba::BigUInt, (aba::BigUIntN<4, uint32_t>)) {
+    REQUIRE(aba::next_prime(TestType(0)) == 2);
+    REQUIRE(aba::next_prime(TestType(2)) == 3);
+    REQUIRE(aba::next_prime(TestType(1'048'571)) == 1'048'573);
+    REQUIRE(aba::next_prime(TestType(1'048'573)) == 1'048'583);
+    REQUIRE(aba::next_prime(TestType(1) << 32) == (TestType(1) << 32) + 15);
+    REQUIRE(aba::next_prime(TestType(1) << 64) == (TestType(1) << 64) + 13);
+    const TestType power_of_ten = TestType(10'000'000'000) * 10'000'000'000;
+    REQUIRE(aba::next_prime(power_of_ten) == power_of_ten + 39);
+    REQUIRE(aba::next_prime(TestType(1) << 96) == (TestType(1) << 96) + 61);
+
+    // 2^128 - 159 is the largest prime below 2^128.
+    REQUIRE(aba::next_prime(TestType(0) - 160) == TestType(0) - 159);
+    REQUIRE_THROWS_AS(aba::next_prime(TestType(0) - 159), std::out_of_range);
+    REQUIRE_THROWS_AS(aba::next_prime(TestType(0) - 1), std::out_of_range);
+}
+
+TEST_CASE("Next prime above the width of a smaller type") {
+    REQUIRE(aba::next_prime(aba::BigUInt256(1) << 128) == (aba::BigUInt256(1) << 128) + 51);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Reproducible random input shared by the tests: a 64 bit linear congruential generator whose state is passed around
+// by the caller, so every test case picks its own seed.
+namespace test {
+
+// Advances the state and returns it with the high bits folded into the weak low ones.
+inline uint64_t next_random(uint64_t& state) {
+    state = state * 6364136223846793005 + 1442695040888963407;
+    return state ^ (state >> 31);
+}
+
+template <typename Limb>
+std::vector<Limb> random_limbs(std::size_t size, uint64_t& state) {
+    std::vector<Limb> result(size);
+    for (auto& limb : result) {
+        limb = static_cast<Limb>(next_random(state));
+    }
+    return result;
+}
+
+// A BigUIntN or BigIntN with the given number of random low limbs and zeros above them. Throws std::out_of_range if T
+// has fewer limbs.
+template <typename T>
+T random_value(std::size_t limbs, uint64_t& state) {
+    if (limbs > T::data_size) {
+        throw std::out_of_range("More random limbs than the value holds");
+    }
+    std::array<typename T::data_t, T::data_size> data{};
+    for (std::size_t i = 0; i < limbs; ++i) {
+        data[i] = static_cast<typename T::data_t>(next_random(state));
+    }
+    return T(data);
+}
+
+} // namespace test
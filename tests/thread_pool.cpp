@@ -0,0 +1,117 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <abacus/integer.hpp>
+#include <abacus/thread_pool.hpp>
+
+#include "random.hpp"
+
+namespace {
+aba::Integer random_integer(std::size_t limbs, uint64_t& state) {
+    return aba::Integer::from_limbs(test::random_limbs<uint64_t>(limbs, state));
+}
+
+// Restores the options the test started with.
+struct ScopedOptions {
+    explicit ScopedOptions(const aba::ParallelOptions& options) { aba::set_parallel_options(options); }
+    ~ScopedOptions() { aba::set_parallel_options(saved); }
+
+    aba::ParallelOptions saved = aba::parallel_options();
+};
+} // namespace
+
+TEST_CASE("Parallel tasks") {
+    const ScopedOptions options({4, 1});
+
+    std::atomic<int> count = 0;
+    aba::detail::parallel_invoke(
+        1, [&] { count += 1; },
+        [&] {
+            // Tasks posting and waiting for tasks of their own.
+            aba::detail::parallel_invoke(
+                1, [&] { count += 10; }, [&] { count += 100; }, [&] { count += 1000; });
+        },
+        [&] { count += 10000; });
+    REQUIRE(count == 11111);
+
+    count = 0;
+    REQUIRE_THROWS_AS(aba::detail::parallel_invoke(
+                          1, [&] { count += 1; }, [] { throw std::runtime_error("task"); }, [&] { count += 1; }),
+                      std::runtime_error);
+    REQUIRE(count == 2);
+
+    // Below the threshold everything runs in order on the calling thread.
+    std::string order;
+    aba::detail::parallel_invoke(
+        0, [&] { order += 'a'; }, [&] { order += 'b'; });
+    REQUIRE(order == "ab");
+}
+
+TEST_CASE("Parallel multiplication matches the single threaded result") {
+    uint64_t state = 23;
+    const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+        {300, 300}, {700, 650}, {1200, 1200}, {900, 4000}, {3500, 3300}, {200, 7000}};
+
+    for (const auto& [lhs_size, rhs_size] : sizes) {
+        INFO(lhs_size << " x " << rhs_size);
+        const auto lhs = random_integer(lhs_size, state);
+        const auto rhs = random_integer(rhs_size, state);
+
+        aba::Integer product;
+        aba::Integer square;
+        {
+            const ScopedOptions options({1, 0});
+            product = lhs * rhs;
+            square = lhs * lhs;
+        }
+        for (const std::size_t threads : {2, 5}) {
+            const ScopedOptions options({threads, 64});
+            REQUIRE(lhs * rhs == product);
+            REQUIRE(lhs * lhs == square);
+        }
+    }
+}
+
+TEST_CASE("Parallel radix conversion") {
+    uint64_t state = 29;
+    const auto value = random_integer(2000, state);
+
+    std::string digits;
+    {
+        const ScopedOptions options({1, 0});
+        digits = value.to_string();
+    }
+    const ScopedOptions options({4, 64});
+    REQUIRE(value.to_string() == digits);
+    REQUIRE(aba::Integer::from_string(digits) == value);
+    REQUIRE(aba::Integer::from_string(value.to_string(7), 7) == value);
+}
+
+TEST_CASE("Parallel radix conversion with cold power tables") {
+    uint64_t state = 31;
+    const std::vector<aba::Integer> values = {random_integer(1500, state), aba::Integer::pow(7, 20001)};
+    const std::vector<uint16_t> bases = {3, 4, 5, 6, 11, 13, 36};
+
+    // The powers and reciprocals of these bases are first computed while conversion tasks are queued.
+    std::vector<std::string> digits;
+    {
+        const ScopedOptions options({4, 16});
+        for (const auto& value : values) {
+            for (const uint16_t base : bases) {
+                digits.push_back(value.to_string(base));
+                REQUIRE(aba::Integer::from_string(digits.back(), base) == value);
+            }
+        }
+    }
+    const ScopedOptions options({1, 0});
+    std::size_t i = 0;
+    for (const auto& value : values) {
+        for (const uint16_t base : bases) {
+            REQUIRE(value.to_string(base) == digits[i++]);
+        }
+    }
+}